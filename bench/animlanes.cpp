@@ -0,0 +1,172 @@
+// Microbenchmark for the batch evaluation of SAnimationLanes against evaluating
+// the animating vars one by one, the way tick() did before the lanes.
+// usage: animlanes [windows] [ticks] (default 500 and 10000)
+// Every window animates its position, size, alpha and border color, so 500 windows are
+// 2000 vars. Only the evaluation is timed, sampling and damage are the same either way.
+// Exits with 1 if the two ever disagree.
+
+#include "../src/helpers/AnimationLanes.hpp"
+
+#include <chrono>
+#include <random>
+#include <stdio.h>
+#include <stdlib.h>
+
+// the value part of CAnimatedVariable from before the lanes, the rest of it
+// (owner pointers, config values, begin time...) is in the way of the cache all the same
+struct SColor4 {
+    float r = 0, g = 0, b = 0, a = 0;
+};
+
+struct SPerVariable {
+    int      type = 0;  // 0 float, 1 vector, 2 color
+    Vector2D vValue, vBegun, vGoal;
+    float    fValue = 0, fBegun = 0, fGoal = 0;
+    SColor4  cValue, cBegun, cGoal;
+    char     rest[96];
+};
+
+static void evaluatePerVariable(std::vector<SPerVariable>& vars, const std::vector<float>& progress) {
+    for (size_t i = 0; i < vars.size(); ++i) {
+        auto&       av = vars[i];
+        const float Y = progress[i];
+
+        switch (av.type) {
+            case 0: av.fValue = av.fBegun + Y * (av.fGoal - av.fBegun); break;
+            case 1: av.vValue = av.vBegun + (av.vGoal - av.vBegun) * Y; break;
+            case 2:
+                av.cValue = {av.cBegun.r + (av.cGoal.r - av.cBegun.r) * Y, av.cBegun.g + (av.cGoal.g - av.cBegun.g) * Y, av.cBegun.b + (av.cGoal.b - av.cBegun.b) * Y,
+                             av.cBegun.a + (av.cGoal.a - av.cBegun.a) * Y};
+                break;
+        }
+    }
+}
+
+template <size_t N>
+static void addLane(SAnimationLanes<N>& lanes, const double* begun, const double* goal) {
+    const size_t I = lanes.size();
+    lanes.resize(I + 1);
+
+    for (size_t c = 0; c < N; ++c) {
+        lanes.begun[c][I] = begun[c];
+        lanes.delta[c][I] = goal[c] - begun[c];
+    }
+}
+
+static float nsSince(std::chrono::steady_clock::time_point begin, int ops) {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - begin).count() / (float)ops;
+}
+
+int main(int argc, char** argv) {
+    const int WINDOWS = argc > 1 ? atoi(argv[1]) : 500;
+    const int TICKS = argc > 2 ? atoi(argv[2]) : 10000;
+
+    std::mt19937                           rng(1337);
+    std::uniform_real_distribution<double> pos(0, 3840), col(0, 1);
+
+    SAnimationLanes<1> floatLanes;
+    SAnimationLanes<2> vectorLanes;
+    SAnimationLanes<4> colorLanes;
+
+    std::vector<SPerVariable> perVariable;
+    // where each var ended up in the lanes, to compare
+    std::vector<std::pair<int, size_t>> laneOf;
+
+    for (int w = 0; w < WINDOWS; ++w) {
+        for (int v = 0; v < 2; ++v) {
+            SPerVariable av;
+            av.type = 1;
+            av.vBegun = Vector2D(pos(rng), pos(rng));
+            av.vGoal = Vector2D(pos(rng), pos(rng));
+            const double BEGUN[] = {av.vBegun.x, av.vBegun.y}, GOAL[] = {av.vGoal.x, av.vGoal.y};
+            laneOf.push_back({1, vectorLanes.size()});
+            addLane(vectorLanes, BEGUN, GOAL);
+            perVariable.push_back(av);
+        }
+
+        SPerVariable alpha;
+        alpha.type = 0;
+        alpha.fBegun = 0.f;
+        alpha.fGoal = 255.f;
+        const double BEGUN[] = {alpha.fBegun}, GOAL[] = {alpha.fGoal};
+        laneOf.push_back({0, floatLanes.size()});
+        addLane(floatLanes, BEGUN, GOAL);
+        perVariable.push_back(alpha);
+
+        SPerVariable border;
+        border.type = 2;
+        border.cBegun = {(float)col(rng), (float)col(rng), (float)col(rng), 1.f};
+        border.cGoal = {(float)col(rng), (float)col(rng), (float)col(rng), 1.f};
+        const double CBEGUN[] = {border.cBegun.r, border.cBegun.g, border.cBegun.b, border.cBegun.a};
+        const double CGOAL[] = {border.cGoal.r, border.cGoal.g, border.cGoal.b, border.cGoal.a};
+        laneOf.push_back({2, colorLanes.size()});
+        addLane(colorLanes, CBEGUN, CGOAL);
+        perVariable.push_back(border);
+    }
+
+    // one progress per var, like the bezier gives, the same for both
+    std::vector<float> progress(perVariable.size());
+    const auto         SETPROGRESS = [&](int tick) {
+        for (size_t i = 0; i < progress.size(); ++i) {
+            progress[i] = std::min(1.f, (tick % 100 + i % 7) / 100.f);
+
+            const auto [TYPE, LANE] = laneOf[i];
+            (TYPE == 0 ? floatLanes.progress : TYPE == 1 ? vectorLanes.progress : colorLanes.progress)[LANE] = progress[i];
+        }
+    };
+
+    // correctness first
+    bool failed = false;
+    for (int tick = 0; tick < 100 && !failed; ++tick) {
+        SETPROGRESS(tick);
+
+        evaluatePerVariable(perVariable, progress);
+        floatLanes.evaluate();
+        vectorLanes.evaluate();
+        colorLanes.evaluate();
+
+        for (size_t i = 0; i < perVariable.size(); ++i) {
+            const auto& AV = perVariable[i];
+            const auto [TYPE, LANE] = laneOf[i];
+
+            double diff = 0;
+            if (TYPE == 0)
+                diff = std::abs(AV.fValue - floatLanes.value[0][LANE]);
+            else if (TYPE == 1)
+                diff = std::max(std::abs(AV.vValue.x - vectorLanes.value[0][LANE]), std::abs(AV.vValue.y - vectorLanes.value[1][LANE]));
+            else
+                diff = std::max({std::abs(AV.cValue.r - colorLanes.value[0][LANE]), std::abs(AV.cValue.g - colorLanes.value[1][LANE]),
+                                 std::abs(AV.cValue.b - colorLanes.value[2][LANE]), std::abs(AV.cValue.a - colorLanes.value[3][LANE])});
+
+            // the per-variable floats and colors are floats, the lanes aren't
+            if (diff > 1e-3) {
+                printf("var %zu (type %i) differs by %f at tick %i\n", i, TYPE, diff, tick);
+                failed = true;
+                break;
+            }
+        }
+    }
+
+    // then the timings, the progress stays put so that only the evaluation is measured
+    SETPROGRESS(42);
+
+    auto begin = std::chrono::steady_clock::now();
+    for (int tick = 0; tick < TICKS; ++tick) {
+        evaluatePerVariable(perVariable, progress);
+        asm volatile("" ::: "memory"); // the same thing every tick, it's not allowed to notice that
+    }
+    const float PERVARIABLENS = nsSince(begin, TICKS);
+
+    begin = std::chrono::steady_clock::now();
+    for (int tick = 0; tick < TICKS; ++tick) {
+        floatLanes.evaluate();
+        vectorLanes.evaluate();
+        colorLanes.evaluate();
+        asm volatile("" ::: "memory");
+    }
+    const float LANESNS = nsSince(begin, TICKS);
+
+    printf("%zu vars (%i windows), per tick: %.0fns one by one, %.0fns in lanes\n", perVariable.size(), WINDOWS, PERVARIABLENS, LANESNS);
+
+    return failed ? 1 : 0;
+}
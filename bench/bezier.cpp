@@ -0,0 +1,110 @@
+// Accuracy check and microbenchmark for CBezierCurve's baked lookups.
+// usage: bezier [lookups] (default 1000000)
+// Compares getYForPoint and getYForPointExact against the curve solved in doubles
+// for a few common curves, exits with 1 if either is further off than it should be.
+
+#include "../src/helpers/BezierCurve.hpp"
+
+#include <chrono>
+#include <random>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+// the curve logs and asserts, nothing to do with either here
+void Debug::log(LogLevel level, const char* fmt, ...) {
+    ;
+}
+
+std::string getFormat(const char* fmt, ...) {
+    char    buf[LOGMESSAGESIZE] = "";
+    va_list args;
+    va_start(args, fmt);
+    vsnprintf(buf, sizeof(buf), fmt, args);
+    va_end(args);
+
+    return buf;
+}
+
+// the lerp in the middle cells, the exact one is Newton to ~1e-7 in x
+constexpr double MAXTABLEERROR = 0.01;
+constexpr double MAXEXACTERROR = 1e-4;
+
+struct SCurve {
+    const char* name;
+    Vector2D    p1, p2;
+};
+
+static double coord(double t, double p1, double p2) {
+    return 3 * t * (1 - t) * (1 - t) * p1 + 3 * t * t * (1 - t) * p2 + t * t * t;
+}
+
+// x is monotonic in t for anything with x in [0, 1], so bisect in doubles
+static double referenceY(const SCurve& curve, double x) {
+    double lower = 0, upper = 1;
+    for (int i = 0; i < 64; ++i) {
+        const double MID = (lower + upper) / 2;
+        if (coord(MID, curve.p1.x, curve.p2.x) > x)
+            upper = MID;
+        else
+            lower = MID;
+    }
+
+    return coord((lower + upper) / 2, curve.p1.y, curve.p2.y);
+}
+
+static float nsSince(std::chrono::steady_clock::time_point begin, int ops) {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - begin).count() / (float)ops;
+}
+
+int main(int argc, char** argv) {
+    const int LOOKUPS = argc > 1 ? atoi(argv[1]) : 1000000;
+
+    const SCurve CURVES[] = {
+        {"default", Vector2D(0, 0.75), Vector2D(0.15, 1)},       {"ease", Vector2D(0.25, 0.1), Vector2D(0.25, 1)},
+        {"ease-in-out", Vector2D(0.42, 0), Vector2D(0.58, 1)},   {"overshot", Vector2D(0.05, 0.9), Vector2D(0.1, 1.1)},
+        {"linear", Vector2D(0.25, 0.25), Vector2D(0.75, 0.75)},
+    };
+
+    std::mt19937                          rng(1337);
+    std::uniform_real_distribution<float> dist(0.f, 1.f);
+    std::vector<float>                    xs(LOOKUPS);
+    for (auto& x : xs)
+        x = dist(rng);
+
+    bool failed = false;
+
+    for (auto& curve : CURVES) {
+        CBezierCurve          bezier;
+        std::vector<Vector2D> points = {curve.p1, curve.p2};
+        bezier.setup(&points);
+
+        double tableError = 0, exactError = 0;
+        for (int i = 0; i <= 10000; ++i) {
+            const float  X = i / 10000.f;
+            const double REFERENCE = referenceY(curve, X);
+
+            tableError = std::max(tableError, std::abs(bezier.getYForPoint(X) - REFERENCE));
+            exactError = std::max(exactError, std::abs(bezier.getYForPointExact(X) - REFERENCE));
+        }
+
+        volatile float sink = 0;
+
+        auto begin = std::chrono::steady_clock::now();
+        for (auto& x : xs)
+            sink = sink + bezier.getYForPoint(x);
+        const float TABLENS = nsSince(begin, LOOKUPS);
+
+        begin = std::chrono::steady_clock::now();
+        for (auto& x : xs)
+            sink = sink + bezier.getYForPointExact(x);
+        const float EXACTNS = nsSince(begin, LOOKUPS);
+
+        const bool OK = tableError <= MAXTABLEERROR && exactError <= MAXEXACTERROR;
+        failed = failed || !OK;
+
+        printf("%-12s max error: %.6f table / %.8f exact, per lookup: %.1fns table / %.1fns exact%s\n", curve.name, tableError, exactError, TABLENS, EXACTNS, OK ? "" : "  <- too far off");
+    }
+
+    return failed ? 1 : 0;
+}
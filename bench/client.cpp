@@ -0,0 +1,328 @@
+// A dumb xdg-shell client for bench/run.sh, draws with wl_shm.
+// usage: benchclient [solid|translucent|animated|shm]
+//  solid        opaque, drawn once
+//  translucent  50% alpha, drawn once (blur goes below it)
+//  animated     redrawn fully every frame
+//  shm          a small square moves every frame, only that is damaged
+
+#include <wayland-client.h>
+#include "xdg-shell-client-protocol.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <string>
+
+enum eMode {
+    MODE_SOLID = 0,
+    MODE_TRANSLUCENT,
+    MODE_ANIMATED,
+    MODE_SHM
+};
+
+constexpr int SQUARE_SIZE = 64;
+
+struct SBuffer {
+    wl_buffer*  buffer = nullptr;
+    uint32_t*   data = nullptr;
+    size_t      size = 0;
+    int         w = 0;
+    int         h = 0;
+    bool        busy = false;
+    int         lastFrame = -1;  // what frame this buffer holds, -1 for nothing
+};
+
+struct SState {
+    wl_display*     display = nullptr;
+    wl_compositor*  compositor = nullptr;
+    wl_shm*         shm = nullptr;
+    xdg_wm_base*    wmBase = nullptr;
+
+    wl_surface*     surface = nullptr;
+    xdg_surface*    xdgSurface = nullptr;
+    xdg_toplevel*   toplevel = nullptr;
+
+    eMode           mode = MODE_SOLID;
+    int             width = 640;
+    int             height = 480;
+    int             pendingWidth = 0;
+    int             pendingHeight = 0;
+    int             frame = 0;
+    int             lastCommittedFrame = -1;
+    bool            configured = false;
+    bool            closed = false;
+
+    SBuffer         buffers[2];
+};
+
+SState g_state;
+
+static void drawFrame();
+
+// ---------------- buffers
+
+static void bufferRelease(void* data, wl_buffer*) {
+    ((SBuffer*)data)->busy = false;
+}
+
+static const wl_buffer_listener bufferListener = {bufferRelease};
+
+static void destroyBuffer(SBuffer* pBuffer) {
+    if (!pBuffer->buffer)
+        return;
+
+    wl_buffer_destroy(pBuffer->buffer);
+    munmap(pBuffer->data, pBuffer->size);
+    *pBuffer = SBuffer();
+}
+
+static bool createBuffer(SBuffer* pBuffer, int w, int h) {
+    const int STRIDE = w * 4;
+    const size_t SIZE = (size_t)STRIDE * h;
+
+    const int FD = memfd_create("benchclient", MFD_CLOEXEC);
+    if (FD < 0 || ftruncate(FD, SIZE) < 0) {
+        fprintf(stderr, "benchclient: couldn't create a shm file\n");
+        return false;
+    }
+
+    pBuffer->data = (uint32_t*)mmap(nullptr, SIZE, PROT_READ | PROT_WRITE, MAP_SHARED, FD, 0);
+    if (pBuffer->data == MAP_FAILED) {
+        close(FD);
+        return false;
+    }
+
+    const auto POOL = wl_shm_create_pool(g_state.shm, FD, SIZE);
+    pBuffer->buffer = wl_shm_pool_create_buffer(POOL, 0, w, h, STRIDE, g_state.mode == MODE_SOLID ? WL_SHM_FORMAT_XRGB8888 : WL_SHM_FORMAT_ARGB8888);
+    wl_shm_pool_destroy(POOL);
+    close(FD);
+
+    wl_buffer_add_listener(pBuffer->buffer, &bufferListener, pBuffer);
+
+    pBuffer->size = SIZE;
+    pBuffer->w = w;
+    pBuffer->h = h;
+
+    return true;
+}
+
+static SBuffer* getFreeBuffer() {
+    for (auto& b : g_state.buffers) {
+        if (b.busy)
+            continue;
+
+        if (b.buffer && (b.w != g_state.width || b.h != g_state.height))
+            destroyBuffer(&b);
+
+        if (!b.buffer && !createBuffer(&b, g_state.width, g_state.height))
+            return nullptr;
+
+        return &b;
+    }
+
+    return nullptr;
+}
+
+// ---------------- drawing
+
+static void fillRect(SBuffer* pBuffer, int x, int y, int w, int h, uint32_t color) {
+    const int X1 = std::clamp(x, 0, pBuffer->w), X2 = std::clamp(x + w, 0, pBuffer->w);
+    const int Y1 = std::clamp(y, 0, pBuffer->h), Y2 = std::clamp(y + h, 0, pBuffer->h);
+
+    for (int j = Y1; j < Y2; ++j)
+        std::fill(pBuffer->data + j * pBuffer->w + X1, pBuffer->data + j * pBuffer->w + X2, color);
+}
+
+static uint32_t backgroundColor() {
+    switch (g_state.mode) {
+        case MODE_TRANSLUCENT: return 0x80182838;  // premultiplied
+        case MODE_ANIMATED: {
+            const uint8_t V = g_state.frame % 256;
+            return 0xFF000000 | (V << 16) | ((255 - V) << 8) | 0x80;
+        }
+        default: return 0xFF3070B0;
+    }
+}
+
+static void squarePos(int frame, int* x, int* y) {
+    const int RANGEX = std::max(1, g_state.width - SQUARE_SIZE);
+    const int RANGEY = std::max(1, g_state.height - SQUARE_SIZE);
+    *x = (frame * 7) % RANGEX;
+    *y = (frame * 3) % RANGEY;
+}
+
+static void frameDone(void*, wl_callback* cb, uint32_t) {
+    wl_callback_destroy(cb);
+
+    g_state.frame++;
+    drawFrame();
+}
+
+static const wl_callback_listener frameListener = {frameDone};
+
+static void drawFrame() {
+    const auto PBUFFER = getFreeBuffer();
+
+    if (!PBUFFER) {
+        // both are with the compositor, try again next frame
+        const auto CB = wl_surface_frame(g_state.surface);
+        wl_callback_add_listener(CB, &frameListener, nullptr);
+        wl_surface_commit(g_state.surface);
+        return;
+    }
+
+    if (g_state.mode == MODE_SHM && PBUFFER->lastFrame >= 0) {
+        // undo the square this buffer has, and damage where it was on the last commit
+        int x, y;
+        squarePos(PBUFFER->lastFrame, &x, &y);
+        fillRect(PBUFFER, x, y, SQUARE_SIZE, SQUARE_SIZE, backgroundColor());
+
+        squarePos(g_state.lastCommittedFrame, &x, &y);
+        wl_surface_damage_buffer(g_state.surface, x, y, SQUARE_SIZE, SQUARE_SIZE);
+    } else {
+        fillRect(PBUFFER, 0, 0, PBUFFER->w, PBUFFER->h, backgroundColor());
+        wl_surface_damage_buffer(g_state.surface, 0, 0, INT32_MAX, INT32_MAX);
+    }
+
+    if (g_state.mode == MODE_SHM) {
+        int x, y;
+        squarePos(g_state.frame, &x, &y);
+        fillRect(PBUFFER, x, y, SQUARE_SIZE, SQUARE_SIZE, 0xFFE0E0E0);
+        wl_surface_damage_buffer(g_state.surface, x, y, SQUARE_SIZE, SQUARE_SIZE);
+    }
+
+    PBUFFER->lastFrame = g_state.frame;
+    g_state.lastCommittedFrame = g_state.frame;
+    PBUFFER->busy = true;
+
+    if (g_state.mode == MODE_ANIMATED || g_state.mode == MODE_SHM) {
+        const auto CB = wl_surface_frame(g_state.surface);
+        wl_callback_add_listener(CB, &frameListener, nullptr);
+    }
+
+    wl_surface_attach(g_state.surface, PBUFFER->buffer, 0, 0);
+    wl_surface_commit(g_state.surface);
+}
+
+// ---------------- xdg
+
+static void wmBasePing(void*, xdg_wm_base* wmBase, uint32_t serial) {
+    xdg_wm_base_pong(wmBase, serial);
+}
+
+static const xdg_wm_base_listener wmBaseListener = {wmBasePing};
+
+static void xdgSurfaceConfigure(void*, xdg_surface* surface, uint32_t serial) {
+    xdg_surface_ack_configure(surface, serial);
+
+    const bool RESIZED = (g_state.pendingWidth > 0 && g_state.pendingWidth != g_state.width) || (g_state.pendingHeight > 0 && g_state.pendingHeight != g_state.height);
+
+    if (g_state.pendingWidth > 0)
+        g_state.width = g_state.pendingWidth;
+    if (g_state.pendingHeight > 0)
+        g_state.height = g_state.pendingHeight;
+
+    if (RESIZED) {
+        // old contents are useless
+        for (auto& b : g_state.buffers)
+            b.lastFrame = -1;
+    }
+
+    // animated ones keep drawing from their frame callbacks
+    if (!g_state.configured || (RESIZED && g_state.mode != MODE_ANIMATED && g_state.mode != MODE_SHM))
+        drawFrame();
+
+    g_state.configured = true;
+}
+
+static const xdg_surface_listener xdgSurfaceListener = {xdgSurfaceConfigure};
+
+static void toplevelConfigure(void*, xdg_toplevel*, int32_t w, int32_t h, wl_array*) {
+    g_state.pendingWidth = w;
+    g_state.pendingHeight = h;
+}
+
+static void toplevelClose(void*, xdg_toplevel*) {
+    g_state.closed = true;
+}
+
+static const xdg_toplevel_listener toplevelListener = {toplevelConfigure, toplevelClose};
+
+// ---------------- registry
+
+static void registryGlobal(void*, wl_registry* registry, uint32_t name, const char* interface, uint32_t version) {
+    if (!strcmp(interface, wl_compositor_interface.name))
+        g_state.compositor = (wl_compositor*)wl_registry_bind(registry, name, &wl_compositor_interface, std::min(version, 4u));  // 4 for damage_buffer
+    else if (!strcmp(interface, wl_shm_interface.name))
+        g_state.shm = (wl_shm*)wl_registry_bind(registry, name, &wl_shm_interface, 1);
+    else if (!strcmp(interface, xdg_wm_base_interface.name)) {
+        g_state.wmBase = (xdg_wm_base*)wl_registry_bind(registry, name, &xdg_wm_base_interface, 1);
+        xdg_wm_base_add_listener(g_state.wmBase, &wmBaseListener, nullptr);
+    }
+}
+
+static void registryGlobalRemove(void*, wl_registry*, uint32_t) {
+    ;
+}
+
+static const wl_registry_listener registryListener = {registryGlobal, registryGlobalRemove};
+
+int main(int argc, char** argv) {
+    const std::string MODE = argc > 1 ? argv[1] : "solid";
+
+    if (MODE == "solid")
+        g_state.mode = MODE_SOLID;
+    else if (MODE == "translucent")
+        g_state.mode = MODE_TRANSLUCENT;
+    else if (MODE == "animated")
+        g_state.mode = MODE_ANIMATED;
+    else if (MODE == "shm")
+        g_state.mode = MODE_SHM;
+    else {
+        fprintf(stderr, "usage: benchclient [solid|translucent|animated|shm]\n");
+        return 1;
+    }
+
+    g_state.display = wl_display_connect(nullptr);
+
+    if (!g_state.display) {
+        fprintf(stderr, "benchclient: couldn't connect to the wayland display\n");
+        return 1;
+    }
+
+    const auto REGISTRY = wl_display_get_registry(g_state.display);
+    wl_registry_add_listener(REGISTRY, &registryListener, nullptr);
+    wl_display_roundtrip(g_state.display);
+
+    if (!g_state.compositor || !g_state.shm || !g_state.wmBase) {
+        fprintf(stderr, "benchclient: missing wl_compositor, wl_shm or xdg_wm_base\n");
+        return 1;
+    }
+
+    g_state.surface = wl_compositor_create_surface(g_state.compositor);
+    g_state.xdgSurface = xdg_wm_base_get_xdg_surface(g_state.wmBase, g_state.surface);
+    xdg_surface_add_listener(g_state.xdgSurface, &xdgSurfaceListener, nullptr);
+    g_state.toplevel = xdg_surface_get_toplevel(g_state.xdgSurface);
+    xdg_toplevel_add_listener(g_state.toplevel, &toplevelListener, nullptr);
+    xdg_toplevel_set_app_id(g_state.toplevel, "benchclient");
+    xdg_toplevel_set_title(g_state.toplevel, ("benchclient " + MODE).c_str());
+    wl_surface_commit(g_state.surface);
+
+    while (!g_state.closed && wl_display_dispatch(g_state.display) != -1) {
+        ;
+    }
+
+    for (auto& b : g_state.buffers)
+        destroyBuffer(&b);
+
+    xdg_toplevel_destroy(g_state.toplevel);
+    xdg_surface_destroy(g_state.xdgSurface);
+    wl_surface_destroy(g_state.surface);
+    wl_display_disconnect(g_state.display);
+
+    return 0;
+}
@@ -0,0 +1,42 @@
+#!/bin/sh
+# Compares two CSVs from bench/run.sh of the same scene, e.g. the base commit's and
+# a change's, recorded on the same machine.
+#
+# usage: bench/compare.sh BASE.csv NEW.csv
+#
+# Fails if the new one renders more than 1.5x slower on average, or issues more than
+# 10% more GL state or draw calls per frame. The timings are noisy on shared machines,
+# hence the generous factor, the call counts aren't.
+
+set -e
+
+if [ $# -ne 2 ]; then
+    sed -n '2,9p' "$0"
+    exit 1
+fi
+
+for csv in "$1" "$2"; do
+    if [ "$(wc -l < "$csv")" -lt 2 ]; then
+        echo "$csv has no frames"
+        exit 1
+    fi
+done
+
+# avg render ms, state calls and draws per frame
+averages() {
+    awk -F, 'NR > 1 { ms += $5; calls += $7; draws += $8 } END { printf "%f %f %f\n", ms / (NR - 1), calls / (NR - 1), draws / (NR - 1) }' "$1"
+}
+
+BASE=$(averages "$1")
+NEW=$(averages "$2")
+
+echo "$BASE $NEW" | awk '{
+    printf "render: %.3f ms -> %.3f ms, state calls: %.1f -> %.1f, draws: %.1f -> %.1f\n", $1, $4, $2, $5, $3, $6
+
+    failed = 0
+    if ($4 > $1 * 1.5) { print "render time regressed"; failed = 1 }
+    if ($5 > $2 * 1.1) { print "state calls per frame regressed"; failed = 1 }
+    if ($6 > $3 * 1.1) { print "draws per frame regressed"; failed = 1 }
+
+    exit failed
+}'
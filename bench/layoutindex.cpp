@@ -0,0 +1,168 @@
+// Microbenchmark for CMonitorLayoutIndex against the linear scan it replaced.
+// usage: layoutindex [damage events] (default 10000)
+// Runs three layouts of 8 outputs: a row, a 4x2 grid and a 2x4 stack with
+// overlaps. Exits with 1 if the index and the scan ever disagree.
+
+#include "../src/helpers/MonitorLayoutIndex.hpp"
+
+#include <chrono>
+#include <random>
+#include <set>
+#include <stdio.h>
+#include <stdlib.h>
+
+constexpr int OUTPUTS = 8;
+constexpr int POINTLOOKUPS = 100000;
+
+// only used as keys, the index never looks into them
+static char g_aFakeMonitors[OUTPUTS];
+
+struct SLayout {
+    const char* name;
+    std::vector<std::pair<SMonitor*, wlr_box>> rects;
+};
+
+static SMonitor* monitor(int i) {
+    return (SMonitor*)&g_aFakeMonitors[i];
+}
+
+static std::vector<SLayout> makeLayouts() {
+    std::vector<SLayout> layouts;
+
+    SLayout row = {"row", {}};
+    for (int i = 0; i < OUTPUTS; ++i)
+        row.rects.push_back({monitor(i), {i * 1920, 0, 1920, 1080}});
+    layouts.push_back(row);
+
+    SLayout grid = {"4x2 grid", {}};
+    for (int i = 0; i < OUTPUTS; ++i)
+        grid.rects.push_back({monitor(i), {(i % 4) * 1920, (i / 4) * 1080, 1920, 1080}});
+    layouts.push_back(grid);
+
+    // two columns of 4, shifted into each other
+    SLayout stacked = {"2x4 stack, overlapping", {}};
+    for (int i = 0; i < OUTPUTS; ++i)
+        stacked.rects.push_back({monitor(i), {(i % 2) * 1600, (i / 2) * 1000, 1920, 1080}});
+    layouts.push_back(stacked);
+
+    return layouts;
+}
+
+static wlr_box layoutBounds(const SLayout& layout) {
+    int x2 = 0, y2 = 0;
+    for (auto& [m, box] : layout.rects) {
+        x2 = std::max(x2, box.x + box.width);
+        y2 = std::max(y2, box.y + box.height);
+    }
+
+    return {0, 0, x2, y2};
+}
+
+static float nsSince(std::chrono::steady_clock::time_point begin, int ops) {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - begin).count() / (float)ops;
+}
+
+int main(int argc, char** argv) {
+    const int DAMAGEEVENTS = argc > 1 ? atoi(argv[1]) : 10000;
+
+    bool failed = false;
+
+    for (auto& layout : makeLayouts()) {
+        CMonitorLayoutIndex index;
+        index.rebuild(layout.rects);
+
+        const auto   BOUNDS = layoutBounds(layout);
+        std::mt19937 rng(1337);
+
+        // damage boxes, window-sized or smaller, some of them crossing output edges or outside of everything
+        std::vector<wlr_box> boxes;
+        for (int i = 0; i < DAMAGEEVENTS; ++i) {
+            const int W = 1 + rng() % 800;
+            const int H = 1 + rng() % 600;
+            boxes.push_back({(int)(rng() % (BOUNDS.width + 400)) - 200, (int)(rng() % (BOUNDS.height + 400)) - 200, W, H});
+        }
+
+        std::vector<Vector2D> points;
+        for (int i = 0; i < POINTLOOKUPS; ++i)
+            points.push_back(Vector2D(rng() % (BOUNDS.width + 100) - 50, rng() % (BOUNDS.height + 100) - 50));
+
+        // correctness first, against the scan
+        int hits = 0;
+        for (auto& box : boxes) {
+            std::set<SMonitor*> fromIndex, fromScan;
+
+            index.forEachIntersecting(box, [&](SMonitor* pMonitor, const wlr_box& intersection) { fromIndex.insert(pMonitor); });
+
+            for (auto& [m, monbox] : layout.rects) {
+                wlr_box intersection;
+                if (wlr_box_intersection(&intersection, &monbox, &box))
+                    fromScan.insert(m);
+            }
+
+            hits += fromIndex.size();
+
+            if (fromIndex != fromScan) {
+                printf("%s: box %i,%i %ix%i: the index found %zu monitors, the scan %zu\n", layout.name, box.x, box.y, box.width, box.height, fromIndex.size(), fromScan.size());
+                failed = true;
+                break;
+            }
+        }
+
+        for (auto& point : points) {
+            const auto PFOUND = index.monitorAt(point);
+
+            // overlapping monitors can give either one, it has to contain the point though
+            bool onAny = false, onFound = false;
+            for (auto& [m, monbox] : layout.rects) {
+                const bool ON = point.x >= monbox.x && point.x < monbox.x + monbox.width && point.y >= monbox.y && point.y < monbox.y + monbox.height;
+                onAny = onAny || ON;
+                onFound = onFound || (ON && m == PFOUND);
+            }
+
+            if (onAny != onFound) {
+                printf("%s: point %.0f,%.0f: the index and the scan disagree\n", layout.name, point.x, point.y);
+                failed = true;
+                break;
+            }
+        }
+
+        // then the timings
+        volatile int sink = 0;
+
+        auto begin = std::chrono::steady_clock::now();
+        for (auto& box : boxes)
+            index.forEachIntersecting(box, [&](SMonitor* pMonitor, const wlr_box& intersection) { sink = sink + intersection.width; });
+        const float INDEXDAMAGENS = nsSince(begin, boxes.size());
+
+        begin = std::chrono::steady_clock::now();
+        for (auto& box : boxes) {
+            for (auto& [m, monbox] : layout.rects) {
+                wlr_box intersection;
+                if (wlr_box_intersection(&intersection, &monbox, &box))
+                    sink = sink + intersection.width;
+            }
+        }
+        const float SCANDAMAGENS = nsSince(begin, boxes.size());
+
+        begin = std::chrono::steady_clock::now();
+        for (auto& point : points)
+            sink = sink + (index.monitorAt(point) != nullptr);
+        const float INDEXPOINTNS = nsSince(begin, points.size());
+
+        begin = std::chrono::steady_clock::now();
+        for (auto& point : points) {
+            for (auto& [m, monbox] : layout.rects) {
+                if (point.x >= monbox.x && point.x < monbox.x + monbox.width && point.y >= monbox.y && point.y < monbox.y + monbox.height) {
+                    sink = sink + 1;
+                    break;
+                }
+            }
+        }
+        const float SCANPOINTNS = nsSince(begin, points.size());
+
+        printf("%s: %i damage events hitting %i monitors, damage: %.1fns index / %.1fns scan, point lookups: %.1fns index / %.1fns scan\n", layout.name, DAMAGEEVENTS,
+               hits, INDEXDAMAGENS, SCANDAMAGENS, INDEXPOINTNS, SCANPOINTNS);
+    }
+
+    return failed ? 1 : 0;
+}
@@ -0,0 +1,326 @@
+#!/bin/sh
+# Runs Hyprland on the headless backend with a software renderer, opens a scene of
+# bench clients and records every frame to a CSV (see hyprctl benchmark).
+#
+# usage: bench/run.sh [options]
+#   -w N        windows per output (default 4)
+#   -W N        spread each output's windows over N workspaces, only the first one is visible (default 1)
+#   -c KINDS    client kinds to cycle through, comma separated (solid,translucent,animated,shm)
+#   -b 0|1      blur (default 1)
+#   -n 0|1      the cached background blur (decoration:blur_new_optimizations, default 1)
+#   -r N        rounding (default 10)
+#   -s N        border size (default 2)
+#   -g 0|1      group the windows, for the group bars (default 0)
+#   -o SCALES   one output per scale, comma separated (default 1)
+#   -m WxH      output resolution (default 1920x1080)
+#   -d SECS     how long to record (default 10)
+#   -z 0|1      drag the split ratio around for the first second, for counting configures (default 0)
+#   -k 0|1      switch workspaces back and forth every half a second while recording (default 0)
+#   -x N        open and close N more windows one after another while recording, for the close animations.
+#               Also a leak test: fails if hyprctl gpumem doesn't get back to where it was before them (default 0)
+#   -a 0|1      keep toggling the focused window floating while recording, that animates it and the one it
+#               shares a split with while everything else idles, for the animation tick times (default 0)
+#   -u 0|1      move a virtual pointer around while recording (needs wlrctl), fails if no frame took the
+#               cursor-only path. Use static clients with it (-c solid) (default 0)
+#   -t 0|1      draw workspace switches from snapshots (animations:workspaces_snapshot, default 0)
+#   -e MODE     general:damage_tracking, none, monitor or full (default full)
+#   -p 0|1      record the first output with wf-recorder (screencopy with damage) while benchmarking (default 0)
+#   -S 0|1      keep the shader cache in bench/.shadercache between runs, to compare the time to the
+#               first frame with a cold and a warm cache (default 0, always cold, Mesa's own is always cold)
+#   -f FILE     output CSV (default ./bench.csv)
+#
+# Build Hyprland, hyprctl and bench/benchclient first (make all, cd bench && make all).
+
+set -e
+
+BENCHDIR=$(cd "$(dirname "$0")" && pwd)
+ROOTDIR=$(dirname "$BENCHDIR")
+
+WINDOWS=4
+WORKSPACES=1
+KINDS="solid,translucent,animated,shm"
+BLUR=1
+BLURCACHE=1
+ROUNDING=10
+BORDER=2
+GROUPWINDOWS=0
+SCALES="1"
+RESOLUTION="1920x1080"
+DURATION=10
+RESIZEDRAG=0
+WSSWITCH=0
+CLOSECYCLES=0
+CURSORMOVE=0
+ANIMATEPAIR=0
+WSSNAPSHOT=0
+DAMAGETRACKING=full
+RECORD=0
+SHADERCACHE=0
+OUTFILE="$(pwd)/bench.csv"
+
+while getopts "w:W:c:b:n:r:s:g:o:m:d:z:k:x:u:a:t:e:p:S:f:" opt; do
+    case $opt in
+        w) WINDOWS=$OPTARG ;;
+        W) WORKSPACES=$OPTARG ;;
+        c) KINDS=$OPTARG ;;
+        b) BLUR=$OPTARG ;;
+        n) BLURCACHE=$OPTARG ;;
+        r) ROUNDING=$OPTARG ;;
+        s) BORDER=$OPTARG ;;
+        g) GROUPWINDOWS=$OPTARG ;;
+        o) SCALES=$OPTARG ;;
+        m) RESOLUTION=$OPTARG ;;
+        d) DURATION=$OPTARG ;;
+        z) RESIZEDRAG=$OPTARG ;;
+        k) WSSWITCH=$OPTARG ;;
+        x) CLOSECYCLES=$OPTARG ;;
+        u) CURSORMOVE=$OPTARG ;;
+        a) ANIMATEPAIR=$OPTARG ;;
+        t) WSSNAPSHOT=$OPTARG ;;
+        e) DAMAGETRACKING=$OPTARG ;;
+        p) RECORD=$OPTARG ;;
+        S) SHADERCACHE=$OPTARG ;;
+        f) OUTFILE=$(realpath -m "$OPTARG") ;;
+        *) sed -n '2,32p' "$0"; exit 1 ;;
+    esac
+done
+
+HYPRLAND="$ROOTDIR/build/Hyprland"
+HYPRCTL="$ROOTDIR/hyprctl/hyprctl"
+CLIENT="$BENCHDIR/benchclient"
+
+for bin in "$HYPRLAND" "$HYPRCTL" "$CLIENT"; do
+    if [ ! -x "$bin" ]; then
+        echo "$bin is missing, build it first"
+        exit 1
+    fi
+done
+
+if [ "$RECORD" = "1" ] && ! command -v wf-recorder > /dev/null; then
+    echo "-p 1 needs wf-recorder"
+    exit 1
+fi
+
+if [ "$CURSORMOVE" = "1" ] && ! command -v wlrctl > /dev/null; then
+    echo "-u 1 needs wlrctl"
+    exit 1
+fi
+
+WORKDIR=$(mktemp -d /tmp/hyprbench.XXXXXX)
+trap 'rm -rf "$WORKDIR"' EXIT
+
+mkdir -p "$WORKDIR/home/.config/hypr" "$WORKDIR/runtime"
+chmod 700 "$WORKDIR/runtime"
+
+# ---- config: one monitor rule per output, laid out left to right
+RESW=${RESOLUTION%x*}
+OUTPUTS=0
+OFFSET=0
+CONFIG="$WORKDIR/home/.config/hypr/hyprland.conf"
+: > "$CONFIG"
+
+for scale in $(echo "$SCALES" | tr ',' ' '); do
+    OUTPUTS=$((OUTPUTS + 1))
+    echo "monitor=HEADLESS-$OUTPUTS,${RESOLUTION}@60,${OFFSET}x0,$scale" >> "$CONFIG"
+    OFFSET=$(awk "BEGIN { printf \"%d\", $OFFSET + $RESW / $scale }")
+done
+
+cat >> "$CONFIG" <<CONF
+general {
+    damage_tracking=$DAMAGETRACKING
+    border_size=$BORDER
+}
+
+decoration {
+    rounding=$ROUNDING
+    blur=$BLUR
+    blur_new_optimizations=$BLURCACHE
+}
+
+animations {
+    workspaces_snapshot=$WSSNAPSHOT
+}
+
+exec-once=$WORKDIR/scene.sh
+CONF
+
+KINDCOUNT=$(echo "$KINDS" | tr ',' '\n' | wc -l)
+
+# ---- the scene, runs inside the compositor so it gets its env
+cat > "$WORKDIR/scene.sh" <<SCENE
+#!/bin/sh
+sleep 1
+
+i=0
+while [ \$i -lt $OUTPUTS ]; do
+    $HYPRCTL dispatch focusmonitor \$i > /dev/null
+
+    n=0
+    while [ \$n -lt $WINDOWS ]; do
+        $CLIENT \$(echo "$KINDS" | cut -d, -f\$((n % $KINDCOUNT + 1))) &
+        sleep 0.3
+
+        # the new window has focus, send it off to one of this output's hidden workspaces
+        if [ \$((n % $WORKSPACES)) -ne 0 ]; then
+            $HYPRCTL dispatch movetoworkspacesilent \$((100 + i * $WORKSPACES + n % $WORKSPACES)) > /dev/null
+        fi
+
+        n=\$((n + 1))
+    done
+
+    if [ "$GROUPWINDOWS" = "1" ]; then
+        $HYPRCTL dispatch togglegroup x > /dev/null
+    fi
+
+    i=\$((i + 1))
+done
+
+# let the open animations finish
+sleep 2
+
+if [ "$RECORD" = "1" ]; then
+    wf-recorder -o HEADLESS-1 -f $WORKDIR/record.mkv > /dev/null 2>&1 &
+    RECORDER=\$!
+    sleep 1
+fi
+
+$HYPRCTL benchmark start "$OUTFILE"
+echo
+
+if [ "$RESIZEDRAG" = "1" ]; then
+    # a second of small steps back and forth, like a mouse resize would do
+    n=0
+    while [ \$n -lt 50 ]; do
+        $HYPRCTL dispatch splitratio \$([ \$((n / 10 % 2)) -eq 0 ] && echo +0.01 || echo -0.01) > /dev/null
+        n=\$((n + 1))
+        sleep 0.02
+    done
+    sleep $((DURATION - 1))
+elif [ "$WSSWITCH" = "1" ]; then
+    $HYPRCTL dispatch focusmonitor 0 > /dev/null
+    n=0
+    while [ \$n -lt $((DURATION * 2)) ]; do
+        $HYPRCTL dispatch workspace \$(((n + 1) % 2 + 1)) > /dev/null
+        n=\$((n + 1))
+        sleep 0.5
+    done
+elif [ "$CLOSECYCLES" -gt 0 ]; then
+    # killing the client unmaps it, which snapshots it for the close animation.
+    # The first few cycles fill the snapshot pool, the baseline is taken after them
+    n=0
+    while [ \$n -lt \$(($CLOSECYCLES + 5)) ]; do
+        if [ \$n -eq 5 ]; then
+            sleep 1
+            $HYPRCTL gpumem | tail -n 1 > $WORKDIR/gpumem.before
+        fi
+
+        $CLIENT solid &
+        CLIENTPID=\$!
+        sleep 0.3
+        kill \$CLIENTPID
+        wait \$CLIENTPID 2> /dev/null
+        sleep 0.2
+        n=\$((n + 1))
+    done
+    # let the last close animation finish
+    sleep 1
+    $HYPRCTL gpumem | tail -n 1 > $WORKDIR/gpumem.after
+elif [ "$ANIMATEPAIR" = "1" ]; then
+    # slower than the animations, so there's a moment of nothing in between
+    n=0
+    while [ \$n -lt $((DURATION * 2)) ]; do
+        $HYPRCTL dispatch togglefloating x > /dev/null
+        n=\$((n + 1))
+        sleep 0.5
+    done
+elif [ "$CURSORMOVE" = "1" ]; then
+    # circles of 40 steps, nothing but the cursor changes
+    n=0
+    while [ \$n -lt $((DURATION * 50)) ]; do
+        case \$((n / 10 % 4)) in
+            0) wlrctl pointer move 10 0 ;;
+            1) wlrctl pointer move 0 10 ;;
+            2) wlrctl pointer move -10 0 ;;
+            3) wlrctl pointer move 0 -10 ;;
+        esac
+        n=\$((n + 1))
+        sleep 0.02
+    done
+else
+    sleep $DURATION
+fi
+
+$HYPRCTL benchmark stop
+echo
+
+$HYPRCTL glstats > $WORKDIR/glstats.txt
+
+if [ "$RECORD" = "1" ]; then
+    kill -INT \$RECORDER
+    wait \$RECORDER
+fi
+
+$HYPRCTL dispatch exit x > /dev/null
+SCENE
+chmod +x "$WORKDIR/scene.sh"
+
+# the home dir is fresh every run, so that cache is always cold
+CACHEDIR="$WORKDIR/home/.cache"
+if [ "$SHADERCACHE" = "1" ]; then
+    CACHEDIR="$BENCHDIR/.shadercache"
+fi
+
+# Mesa's on-disk cache would go into XDG_CACHE_HOME as well and make a warm run faster on its own,
+# so it stays fresh and only hypr/shaders is kept. Not disabled, program binaries need it enabled
+MESACACHEDIR="$WORKDIR/mesa_shader_cache"
+
+EXTRAARGS=""
+if [ "$(id -u)" = "0" ]; then
+    EXTRAARGS="--i-am-really-stupid"
+fi
+
+HOME="$WORKDIR/home" XDG_RUNTIME_DIR="$WORKDIR/runtime" XDG_CACHE_HOME="$CACHEDIR" MESA_SHADER_CACHE_DIR="$MESACACHEDIR" \
+WLR_BACKENDS=headless WLR_HEADLESS_OUTPUTS=$OUTPUTS WLR_LIBINPUT_NO_DEVICES=1 \
+WLR_RENDERER_ALLOW_SOFTWARE=1 LIBGL_ALWAYS_SOFTWARE=1 \
+    timeout $((DURATION + 70 + OUTPUTS * WINDOWS / 2 + CLOSECYCLES)) "$HYPRLAND" $EXTRAARGS > "$WORKDIR/hyprland.log" 2>&1 || {
+    echo "Hyprland exited with an error, last lines of its output:"
+    tail -n 30 "$WORKDIR/hyprland.log"
+    exit 1
+}
+
+if [ ! -s "$OUTFILE" ]; then
+    echo "no frames were recorded"
+    exit 1
+fi
+
+FRAMES=$(($(wc -l < "$OUTFILE") - 1))
+awk -F, 'NR > 1 { ms += $5; if ($5 > max) max = $5; calls += $7; draws += $8; dmg += $9 / $10; dmgcalls += $12 } END { if (NR > 1) printf "frames: %d, avg %.3f ms, max %.3f ms, avg %.1f state calls, %.1f draws, %.1f%% damaged in %.1f damage calls\n", NR - 1, ms / (NR - 1), max, calls / (NR - 1), draws / (NR - 1), dmg * 100 / (NR - 1), dmgcalls / (NR - 1) }' "$OUTFILE"
+awk -F, 'NR > 1 { reused += $6 } END { if (NR > 1) printf "last frame reused: %.1f%%\n", reused * 100 / (NR - 1) }' "$OUTFILE"
+awk -F, 'NR > 1 { tick += $13; if ($13 > maxtick) maxtick = $13 } END { if (NR > 1) printf "animation tick: avg %.3f ms, max %.3f ms\n", tick / (NR - 1), maxtick }' "$OUTFILE"
+awk -F, 'NR == 2 { first = $11 } END { if (NR > 1) printf "configures sent: %d\n", $11 - first }' "$OUTFILE"
+grep -o "First frame after.*" "$WORKDIR/hyprland.log" || true
+echo "$FRAMES frames written to $OUTFILE"
+
+if [ "$CURSORMOVE" = "1" ]; then
+    awk -F, 'NR > 1 { if ($6) { cms += $5; c++ } else { fms += $5; f++ } } END { printf "cursor-only frames: %d, avg %.3f ms, full frames: %d, avg %.3f ms\n", c, c ? cms / c : 0, f, f ? fms / f : 0 }' "$OUTFILE"
+
+    if ! awk -F, 'NR > 1 && $6 { found = 1 } END { exit !found }' "$OUTFILE"; then
+        echo "the pointer moved, but no frame was cursor-only"
+        exit 1
+    fi
+fi
+
+if [ "$CLOSECYCLES" -gt 0 ]; then
+    sed -n '/^Snapshot pool:/,/allocations:/p' "$WORKDIR/glstats.txt"
+    echo "gpumem before: $(cat "$WORKDIR/gpumem.before")"
+    echo "gpumem after:  $(cat "$WORKDIR/gpumem.after")"
+
+    # "total: K KiB in T textures, F framebuffers[, L without an owner]", freeing more than before is fine
+    # (an idle blur FB can time out in between), anything more or ownerless is a leak
+    if grep -q "without an owner" "$WORKDIR/gpumem.after" || ! awk '
+        { gsub(/,/, ""); kib[NR] = $2; tex[NR] = $5; fbs[NR] = $7 }
+        END { exit !(NR == 2 && kib[2] <= kib[1] && tex[2] <= tex[1] && fbs[2] <= fbs[1]) }' "$WORKDIR/gpumem.before" "$WORKDIR/gpumem.after"; then
+        echo "GPU resources leaked over $CLOSECYCLES windows"
+        exit 1
+    fi
+fi
@@ -24,6 +24,10 @@ usage: hyprctl [command] [(opt)args]
     activewindow
     layers
     devices
+    glstats
+    latency
+    gpumem
+    benchmark start [path] / benchmark stop
     dispatch
     keyword
     version
@@ -111,6 +115,20 @@ void keywordRequest(int argc, char** argv) {
     request(rq);
 }
 
+void benchmarkRequest(int argc, char** argv) {
+    if (argc < 3) {
+        std::cout << "benchmark requires start [path] or stop";
+        return;
+    }
+
+    std::string rq = "benchmark " + std::string(argv[2]);
+
+    if (argc > 3)
+        rq += " " + std::string(argv[3]);
+
+    request(rq);
+}
+
 void batchRequest(int argc, char** argv) {
     std::string rq = "[[BATCH]]" + std::string(argv[2]);
     
@@ -132,7 +150,11 @@ int main(int argc, char** argv) {
     else if (!strcmp(argv[1], "layers")) request("layers");
     else if (!strcmp(argv[1], "version")) request("version");
     else if (!strcmp(argv[1], "devices")) request("devices");
+    else if (!strcmp(argv[1], "glstats")) request("glstats");
+    else if (!strcmp(argv[1], "latency")) request("latency");
+    else if (!strcmp(argv[1], "gpumem")) request("gpumem");
     else if (!strcmp(argv[1], "reload")) request("reload");
+    else if (!strcmp(argv[1], "benchmark")) benchmarkRequest(argc, argv);
     else if (!strcmp(argv[1], "dispatch")) dispatchRequest(argc, argv);
     else if (!strcmp(argv[1], "keyword")) keywordRequest(argc, argv);
     else if (!strcmp(argv[1], "--batch")) batchRequest(argc, argv);
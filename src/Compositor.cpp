@@ -168,6 +168,12 @@ void CCompositor::cleanupExit() {
     m_sWLDisplay = nullptr;
 }
 
+int handleHousekeeping(void* data) {
+    g_pCompositor->housekeeping();
+
+    return 0;
+}
+
 void CCompositor::startCompositor() {
     // Init all the managers BEFORE we start with the wayland server so that ALL of the stuff is initialized
     // properly and we dont get any bad mem reads.
@@ -196,6 +202,9 @@ void CCompositor::startCompositor() {
     Debug::log(LOG, "Creating the HyprRenderer!");
     g_pHyprRenderer = std::make_unique<CHyprRenderer>();
 
+    Debug::log(LOG, "Creating the ThumbnailManager!");
+    g_pThumbnailManager = std::make_unique<CThumbnailManager>();
+
     Debug::log(LOG, "Creating the XWaylandManager!");
     g_pXWaylandManager = std::make_unique<CHyprXWaylandManager>();
 
@@ -208,11 +217,16 @@ void CCompositor::startCompositor() {
 
     Debug::log(LOG, "Creating the HyprDebugOverlay!");
     g_pDebugOverlay = std::make_unique<CHyprDebugOverlay>();
+
+    Debug::log(LOG, "Creating the RenderBenchmark!");
+    g_pRenderBenchmark = std::make_unique<CRenderBenchmark>();
     //
     //
 
     initAllSignals();
 
+    m_pHousekeepingTimer = wl_event_loop_add_timer(wl_display_get_event_loop(m_sWLDisplay), &handleHousekeeping, nullptr);
+
     // Set some env vars so that Firefox is automatically in Wayland mode
     // and QT apps too
     // electron needs -- flags so we can't really set them here
@@ -277,9 +291,9 @@ SMonitor* CCompositor::getMonitorFromCursor() {
 }
 
 SMonitor* CCompositor::getMonitorFromVector(const Vector2D& point) {
-    const auto OUTPUT = wlr_output_layout_output_at(m_sWLROutputLayout, point.x, point.y);
+    const auto PMONITOR = m_sMonitorLayoutIndex.monitorAt(point);
 
-    if (!OUTPUT) {
+    if (!PMONITOR) {
         float bestDistance = 0.f;
         SMonitor* pBestMon = nullptr;
 
@@ -300,12 +314,14 @@ SMonitor* CCompositor::getMonitorFromVector(const Vector2D& point) {
         return pBestMon;
     }
 
-    return getMonitorFromOutput(OUTPUT);
+    return PMONITOR;
 }
 
 void CCompositor::removeWindowFromVectorSafe(CWindow* pWindow) {
-    if (windowExists(pWindow) && !pWindow->m_bFadingOut)
+    if (windowExists(pWindow) && !pWindow->m_bFadingOut) {
         m_lWindows.remove(*pWindow);
+        g_pHyprRenderer->invalidateRenderList();
+    }
 }
 
 bool CCompositor::windowExists(CWindow* pWindow) {
@@ -714,6 +730,7 @@ void CCompositor::moveWindowToTop(CWindow* pWindow) {
     for (auto it = m_lWindows.begin(); it != m_lWindows.end(); ++it) {
         if (&(*it) == pWindow) {
             m_lWindows.splice(m_lWindows.end(), m_lWindows, it);
+            g_pHyprRenderer->invalidateRenderList();
             break;
         }
     }
@@ -728,10 +745,10 @@ void CCompositor::cleanupFadingOut() {
             if (valid && !w->m_bReadyToDelete)
                 continue;
 
-            g_pHyprOpenGL->m_mWindowFramebuffers[w].release();
-            g_pHyprOpenGL->m_mWindowFramebuffers.erase(w);
+            g_pHyprOpenGL->releaseSnapshot(w);
             m_lWindows.remove(*w);
             m_lWindowsFadingOut.remove(w);
+            g_pHyprRenderer->invalidateRenderList();
 
             Debug::log(LOG, "Cleanup: destroyed a window");
             return;
@@ -746,8 +763,7 @@ void CCompositor::cleanupFadingOut() {
                 }
             }
 
-            g_pHyprOpenGL->m_mLayerFramebuffers[ls].release();
-            g_pHyprOpenGL->m_mLayerFramebuffers.erase(ls);
+            g_pHyprOpenGL->releaseSnapshot(ls);
             
             delete ls;
             m_lSurfacesFadingOut.remove(ls);
@@ -1089,4 +1105,42 @@ bool CCompositor::workspaceIDOutOfBounds(const int& id) {
     }
 
     return std::clamp(id, lowestID, highestID) != id;
-}
\ No newline at end of file
+}
+
+void CCompositor::scheduleHousekeeping(int delayMs) {
+    // an earlier one is pending already
+    if (m_bHousekeepingScheduled && delayMs > 1)
+        return;
+
+    m_bHousekeepingScheduled = true;
+    wl_event_source_timer_update(m_pHousekeepingTimer, delayMs);
+}
+
+void CCompositor::housekeeping() {
+    m_bHousekeepingScheduled = false;
+
+    sanityCheckWorkspaces();
+
+    // cleanupFadingOut only gets rid of one at a time
+    size_t fadingOut = 0;
+    do {
+        fadingOut = m_lWindowsFadingOut.size() + m_lSurfacesFadingOut.size();
+        cleanupFadingOut();
+    } while (m_lWindowsFadingOut.size() + m_lSurfacesFadingOut.size() < fadingOut);
+
+    if (g_pConfigManager->m_bWantsMonitorReload)
+        g_pConfigManager->performMonitorReload();
+
+    // the first load doesn't wake us up
+    g_pConfigManager->applyBeziers();
+
+    // blur buffers that went unused for a while, check again later if some are left
+    if (g_pHyprOpenGL->releaseIdleBlurBuffers())
+        scheduleHousekeeping(1000);
+
+    g_pHyprOpenGL->m_sGPUResources.checkOwners();
+
+    // fading out stuff might still be waiting for a destroy, check again in a bit
+    if (!m_lWindowsFadingOut.empty() || !m_lSurfacesFadingOut.empty())
+        scheduleHousekeeping(100);
+}
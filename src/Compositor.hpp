@@ -15,8 +15,11 @@
 #include "managers/KeybindManager.hpp"
 #include "managers/AnimationManager.hpp"
 #include "managers/EventManager.hpp"
+#include "managers/ThumbnailManager.hpp"
 #include "debug/HyprDebugOverlay.hpp"
+#include "debug/RenderBenchmark.hpp"
 #include "helpers/Monitor.hpp"
+#include "helpers/MonitorLayoutIndex.hpp"
 #include "helpers/Workspace.hpp"
 #include "Window.hpp"
 #include "render/Renderer.hpp"
@@ -73,6 +76,8 @@ public:
     std::list<CWindow*>     m_lWindowsFadingOut;
     std::list<SLayerSurface*> m_lSurfacesFadingOut;
 
+    CMonitorLayoutIndex     m_sMonitorLayoutIndex;
+
     void                    startCompositor(); 
     void                    cleanupExit();
 
@@ -84,6 +89,8 @@ public:
 
     bool                    m_bReadyToProcess = false;
 
+    std::chrono::steady_clock::time_point m_tStartTime = std::chrono::steady_clock::now();  // for the time to the first frame
+
     // ------------------------------------------------- //
 
     SMonitor*               getMonitorFromID(const int&);
@@ -131,9 +138,14 @@ public:
     int                     getNextAvailableMonitorID();
     void                    moveWorkspaceToMonitor(CWorkspace*, SMonitor*);
     bool                    workspaceIDOutOfBounds(const int&);
+    void                    scheduleHousekeeping(int delayMs = 1);
+    void                    housekeeping();
 
 private:
     void                    initAllSignals();
+
+    wl_event_source*        m_pHousekeepingTimer = nullptr;
+    bool                    m_bHousekeepingScheduled = false;
 };
 
 
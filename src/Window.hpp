@@ -76,6 +76,13 @@ public:
     // For nofocus
     bool            m_bNoFocus = false;
 
+    // Configures, sent at most once a frame, see CHyprXWaylandManager::setWindowSize
+    Vector2D        m_vConfigureQueuedSize = Vector2D(-1, -1);
+    bool            m_bConfigureQueued = false;
+    Vector2D        m_vConfigureSentSize = Vector2D(-1, -1);  // last one sent, acked or not
+    Vector2D        m_vConfigureSentPos = Vector2D(-1, -1);   // X11 only, its configures carry the position
+    uint32_t        m_iConfigureSerial = 0;                   // XDG only
+
     SSurfaceTreeNode* m_pSurfaceTree = nullptr;
 
     // Animated border
@@ -10,6 +10,8 @@
 #include <fstream>
 #include <iostream>
 
+std::mutex configmtx;
+
 CConfigManager::CConfigManager() {
     setDefaultVars();
     static const char* const ENVHOME = getenv("HOME");
@@ -32,16 +34,25 @@ void CConfigManager::setDefaultVars() {
     configValues["general:gaps_out"].intValue = 20;
     configValues["general:col.active_border"].intValue = 0xffffffff;
     configValues["general:col.inactive_border"].intValue = 0xff444444;
+    configValues["general:late_latch"].intValue = 0;
+    configValues["general:late_latch_margin"].floatValue = 2.f;  // ms
+    configValues["general:configure_wait_ack"].intValue = 0;
+    configValues["general:thumbnail_scale"].floatValue = 0.25f;
+    configValues["general:thumbnail_max_fps"].intValue = 5;
+    configValues["general:thumbnail_budget"].intValue = 1;  // thumbnails rendered per monitor frame
 
     configValues["debug:int"].intValue = 0;
     configValues["debug:log_damage"].intValue = 0;
     configValues["debug:overlay"].intValue = 0;
+    configValues["debug:log_presentation"].intValue = 0;
 
     configValues["decoration:rounding"].intValue = 1;
     configValues["decoration:blur"].intValue = 1;
     configValues["decoration:blur_size"].intValue = 8;
     configValues["decoration:blur_passes"].intValue = 1;
     configValues["decoration:blur_ignore_opacity"].intValue = 0;
+    configValues["decoration:blur_new_optimizations"].intValue = 1;
+    configValues["decoration:blur_release_timeout"].intValue = 10;  // seconds, 0 to never release
     configValues["decoration:active_opacity"].floatValue = 1;
     configValues["decoration:inactive_opacity"].floatValue = 1;
     configValues["decoration:fullscreen_opacity"].floatValue = 1;
@@ -73,6 +84,8 @@ void CConfigManager::setDefaultVars() {
     configValues["animations:workspaces_curve"].strValue = "[[f]]";
     configValues["animations:workspaces_speed"].floatValue = 0.f;
     configValues["animations:workspaces"].intValue = 1;
+    configValues["animations:workspaces_snapshot"].intValue = 0;
+    configValues["animations:workspaces_snapshot_refresh"].intValue = 0;  // Hz, 0 to never refresh during the switch
 
     configValues["input:kb_layout"].strValue = "en";
     configValues["input:kb_variant"].strValue = STRVAL_EMPTY;
@@ -309,7 +322,8 @@ void CConfigManager::handleBezier(const std::string& command, const std::string&
     nextItem();
     float p2y = std::stof(curitem);
 
-    g_pAnimationManager->addBezierWithName(bezierName, Vector2D(p1x, p1y), Vector2D(p2x, p2y));
+    // the animation manager gets it on the main thread, see publishBeziers
+    m_dBezierDefinitions.push_back({bezierName, Vector2D(p1x, p1y), Vector2D(p2x, p2y)});
 }
 
 void CConfigManager::handleAnimation(const std::string& command, const std::string& args) {
@@ -508,6 +522,63 @@ void CConfigManager::handleSource(const std::string& command, const std::string&
     }
 }
 
+void CConfigManager::publishBeziers() {
+    // the names are checked here, so that a wrong one shows up with the rest of the config's errors
+    std::unordered_map<std::string, std::string> curveNames;
+
+    for (auto& [name, value] : configValues) {
+        if (name.find("animations:") != 0 || name.rfind("curve") != name.length() - 5)
+            continue;
+
+        curveNames[name] = value.strValue;
+
+        if (value.strValue == "[[f]]" || value.strValue == STRVAL_EMPTY || value.strValue == "default")
+            continue;
+
+        if (std::none_of(m_dBezierDefinitions.begin(), m_dBezierDefinitions.end(), [&](const SBezierDefinition& b) { return b.name == value.strValue; }))
+            parseError = "no such bezier curve: " + value.strValue + " (in " + name + ")";
+    }
+
+    std::lock_guard<std::mutex> lg(configmtx);
+
+    m_dPublishedBeziers = m_dBezierDefinitions;
+    m_mPublishedCurveNames = curveNames;
+    m_bBeziersPublished = true;
+}
+
+void CConfigManager::applyBeziers() {
+    std::deque<SBezierDefinition> beziers;
+    std::unordered_map<std::string, std::string> curveNames;
+
+    {
+        std::lock_guard<std::mutex> lg(configmtx);
+
+        if (!m_bBeziersPublished)
+            return;
+
+        beziers.swap(m_dPublishedBeziers);
+        curveNames.swap(m_mPublishedCurveNames);
+        m_bBeziersPublished = false;
+    }
+
+    g_pAnimationManager->removeAllBeziers();
+    for (auto& b : beziers)
+        g_pAnimationManager->addBezierWithName(b.name, b.p1, b.p2);
+
+    // tick() only ever reads the IDs, so it doesn't have to look curves up by name
+    for (auto& [name, curve] : curveNames)
+        *getCurveIDPtr(name) = g_pAnimationManager->getBezierID(curve);
+
+    if (*getCurveIDPtr("animations:curve") == -1)
+        *getCurveIDPtr("animations:curve") = 0;
+}
+
+int64_t* CConfigManager::getCurveIDPtr(const std::string& name) {
+    // unordered_map doesn't move its values, the vars can keep the pointer
+    const auto IT = m_mCurveIDs.try_emplace(name, -1).first;
+    return &IT->second;
+}
+
 std::string CConfigManager::parseKeyword(const std::string& COMMAND, const std::string& VALUE, bool dynamic) {
     if (dynamic) {
         parseError = "";
@@ -537,6 +608,10 @@ std::string CConfigManager::parseKeyword(const std::string& COMMAND, const std::
         configSetValueSafe(currentCategory + (currentCategory == "" ? "" : ":") + COMMAND, VALUE);
 
     if (dynamic) {
+        // this is the main thread already
+        publishBeziers();
+        applyBeziers();
+
         std::string retval = parseError;
         parseError = "";
 
@@ -631,7 +706,7 @@ void CConfigManager::loadConfigLoadVars() {
     m_dMonitorRules.clear();
     m_dWindowRules.clear();
     g_pKeybindManager->clearKeybinds();
-    g_pAnimationManager->removeAllBeziers();
+    m_dBezierDefinitions.clear();
     m_mAdditionalReservedAreas.clear();
     configDynamicVars.clear();
 
@@ -709,6 +784,9 @@ void CConfigManager::loadConfigLoadVars() {
         configValues["general:damage_tracking_internal"].intValue = DAMAGE_TRACKING_NONE;
     }
 
+    // applied on the main thread, see applyBeziers
+    publishBeziers();
+
     // parseError will be displayed next frame
     if (parseError != "")
         g_pHyprError->queueCreate(parseError + "\nHyprland may not work correctly.", CColor(255, 50, 50, 255));
@@ -759,10 +837,12 @@ void CConfigManager::tick() {
         m_bForceReload = false;
 
         loadConfigLoadVars();
+
+        // apply the monitor rules, show errors etc. on the main thread
+        g_pThreadManager->wakeMainThread();
     }
 }
 
-std::mutex configmtx;
 SConfigValue CConfigManager::getConfigValueSafe(std::string val) {
     std::lock_guard<std::mutex> lg(configmtx);
 
@@ -45,6 +45,12 @@ struct SWindowRule {
     std::string szValue;
 };
 
+struct SBezierDefinition {
+    std::string name;
+    Vector2D    p1;
+    Vector2D    p2;
+};
+
 class CConfigManager {
 public:
     CConfigManager();
@@ -76,6 +82,11 @@ public:
 
     std::string         parseKeyword(const std::string&, const std::string&, bool dynamic = false);
 
+    // main thread. Gives the animation manager the curves of the last load and resolves the animations:*curve names
+    void                applyBeziers();
+    // the curve ID an animations:*curve value resolved to, for the animated vars. Main thread only
+    int64_t*            getCurveIDPtr(const std::string&);
+
 private:
     std::deque<std::string>                       configPaths; // stores all the config paths
     std::unordered_map<std::string, time_t>       configModifyTimes; // stores modify times
@@ -96,11 +107,21 @@ private:
     bool firstExecDispatched = false;
     std::deque<std::string> firstExecRequests;
 
+    std::deque<SBezierDefinition> m_dBezierDefinitions;  // of the load in progress
+
+    // handed over from the config thread under the config mutex, the animation manager is the main thread's
+    std::deque<SBezierDefinition>                 m_dPublishedBeziers;
+    std::unordered_map<std::string, std::string>  m_mPublishedCurveNames;  // animations:*curve -> curve name
+    bool                                          m_bBeziersPublished = false;
+
+    std::unordered_map<std::string, int64_t>      m_mCurveIDs;  // animations:*curve -> curve ID, -1 is animations:curve
+
     // internal methods
     void                setDefaultVars();
 
     void                applyUserDefinedVars(std::string&, const size_t);
     void                loadConfigLoadVars();
+    void                publishBeziers();
     SConfigValue        getConfigValueSafe(std::string);
     void                parseLine(std::string&);
     void                configSetValueSafe(const std::string&, const std::string&);
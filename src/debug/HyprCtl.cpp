@@ -149,6 +149,84 @@ std::string dispatchKeyword(std::string in) {
     return retval;
 }
 
+std::string glStatsRequest() {
+    std::string result = "";
+    for (auto& m : g_pCompositor->m_lMonitors) {
+        const auto IT = g_pHyprOpenGL->m_mMonitorRenderResources.find(&m);
+
+        if (IT == g_pHyprOpenGL->m_mMonitorRenderResources.end())
+            continue;
+
+        const auto TOTAL = IT->second.glCallsIssued + IT->second.glCallsElided;
+
+        // RGBA8, 4 bytes a pixel
+        const auto FBKIB = [](const CFramebuffer& fb) { return fb.m_cTex.m_iTexID ? (int)(fb.m_Size.x * fb.m_Size.y * 4 / 1024) : 0; };
+
+        // depth24 + stencil8 at the primary FB's size, 4 bytes a pixel as well. Never allocated on GLES2
+#ifndef GLES2
+        const int STENCILKIB = IT->second.stencilTex.m_iTexID && IT->second.primaryFB.m_cTex.m_iTexID ? (int)(IT->second.primaryFB.m_Size.x * IT->second.primaryFB.m_Size.y * 4 / 1024) : 0;
+#else
+        const int STENCILKIB = 0;
+#endif
+
+        result += getFormat("Monitor %s (ID %i):\n\tstate calls issued: %i\n\tstate calls elided: %i (%i%%)\n\tdraw calls: %i\n",
+                            m.szName.c_str(), m.ID, IT->second.glCallsIssued, IT->second.glCallsElided, TOTAL == 0 ? 0 : (int)(IT->second.glCallsElided * 100.f / TOTAL), IT->second.glDrawCalls);
+        result += getFormat("\tbuffers: primary %i KiB, stencil %i KiB, mirror %i KiB, mirror swap %i KiB, blur cache %i KiB\n",
+                            FBKIB(IT->second.primaryFB), STENCILKIB, FBKIB(IT->second.mirrorFB), FBKIB(IT->second.mirrorSwapFB), FBKIB(IT->second.blurFB));
+        result += getFormat("\tframes: %i, cursor-only: %i (%i%%)\n\n", m.framesRendered, m.framesCursorOnly, m.framesRendered == 0 ? 0 : (int)(m.framesCursorOnly * 100.f / m.framesRendered));
+    }
+
+    const auto PPOOL = &g_pHyprOpenGL->m_sSnapshotPool;
+    result += getFormat("Snapshot pool:\n\tallocated: %i KiB\n\tin use: %i KiB\n\treused: %i\n\tallocations: %i\n", (int)(PPOOL->m_iBytesAllocated / 1024), (int)(PPOOL->m_iBytesInUse / 1024), PPOOL->m_iHits, PPOOL->m_iMisses);
+    result += getFormat("Configures:\n\tsent: %i\n\tskipped: %i\n\tcoalesced: %i\n", g_pXWaylandManager->m_iConfiguresSent, g_pXWaylandManager->m_iConfiguresSkipped, g_pXWaylandManager->m_iConfiguresCoalesced);
+    result += getFormat("Thumbnails:\n\trendered: %i\n\tcopied: %i\n", g_pThumbnailManager->m_iThumbnailsRendered, g_pThumbnailManager->m_iFramesCopied);
+
+    const auto& SHADERCACHE = g_pHyprOpenGL->m_sShaderCache;
+    result += getFormat("Shaders:\n\tcache: %s\n\tcache hits: %i\n\tcache misses: %i\n\tbuilt in the background: %i\n\tframes that waited: %i\n\tinit: %.2fms\n\tfirst frame: %.2fms\n", SHADERCACHE.m_bEnabled ? "enabled" : "disabled",
+                        SHADERCACHE.m_iHits.load(), SHADERCACHE.m_iMisses.load(), g_pHyprOpenGL->m_iShadersBuiltAsync, g_pHyprOpenGL->m_iShaderWaits, g_pHyprOpenGL->m_fShaderInitMs, g_pHyprOpenGL->m_fFirstFrameMs);
+
+    return result;
+}
+
+std::string gpuMemRequest() {
+    return g_pHyprOpenGL->m_sGPUResources.getReport();
+}
+
+std::string benchmarkRequest(std::string request) {
+    // benchmark start <path> / benchmark stop
+    std::string args = request.substr(request.find_first_of(' ') + 1);
+
+    if (args.find("start") == 0) {
+        const auto PATH = removeBeginEndSpacesTabs(args.substr(5));
+
+        if (PATH.empty())
+            return "benchmark start requires a path";
+
+        return g_pRenderBenchmark->start(PATH);
+    } else if (args == "stop") {
+        return g_pRenderBenchmark->stop();
+    }
+
+    return "invalid benchmark args, use start <path> or stop";
+}
+
+std::string latencyRequest() {
+    std::string result = "";
+    for (auto& m : g_pCompositor->m_lMonitors) {
+        float renderAvg = 0, renderMax = 0;
+        const auto COUNT = std::min(m.renderTimesCount, m.renderTimesMs.size());
+        for (size_t i = 0; i < COUNT; ++i) {
+            renderAvg += m.renderTimesMs[i] / COUNT;
+            renderMax = std::max(renderMax, m.renderTimesMs[i]);
+        }
+
+        result += getFormat("Monitor %s (ID %i):\n\trender time: %.2fms avg, %.2fms max\n\tlate latch: %s, delayed by %ims\n\trender to present: %.2fms\n\tinput to present: %.2fms\n\n",
+                            m.szName.c_str(), m.ID, renderAvg, renderMax, g_pConfigManager->getInt("general:late_latch") == 1 ? "on" : "off", m.lateLatchDelayMs, m.renderToPresentMs, m.inputToPresentMs);
+    }
+
+    return result;
+}
+
 std::string reloadRequest() {
     g_pConfigManager->m_bForceReload = true;
 
@@ -206,6 +284,14 @@ std::string getReply(std::string request) {
         return reloadRequest();
     else if (request == "devices")
         return devicesRequest();
+    else if (request == "glstats")
+        return glStatsRequest();
+    else if (request == "latency")
+        return latencyRequest();
+    else if (request == "gpumem")
+        return gpuMemRequest();
+    else if (request.find("benchmark") == 0)
+        return benchmarkRequest(request);
     else if (request.find("dispatch") == 0)
         return dispatchRequest(request);
     else if (request.find("keyword") == 0)
@@ -243,6 +329,8 @@ std::string getRequestFromThread(std::string rq) {
     HyprCtl::request = rq;
     HyprCtl::requestMade = true;
 
+    g_pThreadManager->wakeMainThread();
+
     while (!HyprCtl::requestReady) {
         std::this_thread::sleep_for(std::chrono::milliseconds(5));
     }
@@ -117,6 +117,20 @@ int CHyprMonitorDebugOverlay::draw(int offset) {
     cairo_text_extents(g_pDebugOverlay->m_pCairo, text.c_str(), &cairoExtents);
     if (cairoExtents.width > maxX) maxX = cairoExtents.width;
 
+    // don't create the render data with [], begin() only checks if it's there
+    const auto ITMONITORDATA = g_pHyprOpenGL->m_mMonitorRenderResources.find(m_pMonitor);
+
+    if (ITMONITORDATA != g_pHyprOpenGL->m_mMonitorRenderResources.end()) {
+        const auto PMONITORDATA = &ITMONITORDATA->second;
+
+        yOffset += 11;
+        cairo_move_to(g_pDebugOverlay->m_pCairo, 0, yOffset);
+        text = std::string("GL state calls: " + std::to_string(PMONITORDATA->glCallsIssued) + " issued, " + std::to_string(PMONITORDATA->glCallsElided) + " elided, " + std::to_string(PMONITORDATA->glDrawCalls) + " draws");
+        cairo_show_text(g_pDebugOverlay->m_pCairo, text.c_str());
+        cairo_text_extents(g_pDebugOverlay->m_pCairo, text.c_str(), &cairoExtents);
+        if (cairoExtents.width > maxX) maxX = cairoExtents.width;
+    }
+
     yOffset += 11;
 
     g_pHyprRenderer->damageBox(&m_wbLastDrawnBox);
@@ -164,17 +178,18 @@ void CHyprDebugOverlay::draw() {
 
     // copy the data to an OpenGL texture we have
     const auto DATA = cairo_image_surface_get_data(m_pCairoSurface);
-    m_tTexture.allocate();
-    glBindTexture(GL_TEXTURE_2D, m_tTexture.m_iTexID);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    m_tTexture.allocate({GPU_OWNER_COMPOSITOR, nullptr, "debug overlay"});
+    g_pHyprOpenGL->m_sGLState.bindTexture(GL_TEXTURE_2D, m_tTexture.m_iTexID);
+    g_pHyprOpenGL->m_sGLState.texParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    g_pHyprOpenGL->m_sGLState.texParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
 
 #ifndef GLES2
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_R, GL_BLUE);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_B, GL_RED);
+    g_pHyprOpenGL->m_sGLState.texParameteri(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_R, GL_BLUE);
+    g_pHyprOpenGL->m_sGLState.texParameteri(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_B, GL_RED);
 #endif
 
     glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, PMONITOR->vecSize.x, PMONITOR->vecSize.y, 0, GL_RGBA, GL_UNSIGNED_BYTE, DATA);
+    g_pHyprOpenGL->m_sGPUResources.setStorage(m_tTexture.m_iTexID, PMONITOR->vecSize, "RGBA8", 4);
 
     wlr_box pMonBox = {0,0,PMONITOR->vecPixelSize.x, PMONITOR->vecPixelSize.y};
     g_pHyprOpenGL->renderTexture(m_tTexture, &pMonBox, 255.f);
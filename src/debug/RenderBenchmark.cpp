@@ -0,0 +1,50 @@
+#include "RenderBenchmark.hpp"
+#include "../render/OpenGL.hpp"
+#include "../managers/XWaylandManager.hpp"
+
+std::string CRenderBenchmark::start(const std::string& path) {
+    if (m_bRunning)
+        return "already running, writing to " + m_szPath;
+
+    m_ofFile.open(path, std::ios::trunc);
+
+    if (!m_ofFile.good())
+        return "couldn't open " + path;
+
+    m_ofFile << "time_ms,monitor,scale,frame,render_ms,cursor_only,gl_state_calls,gl_draw_calls,damage_px,monitor_px,configures_sent,damage_calls,anim_tick_ms\n";
+
+    m_szPath = path;
+    m_iFrames = 0;
+    m_tpStart = std::chrono::steady_clock::now();
+    m_bRunning = true;
+
+    Debug::log(LOG, "Render benchmark started, writing to %s", path.c_str());
+
+    return "ok";
+}
+
+std::string CRenderBenchmark::stop() {
+    if (!m_bRunning)
+        return "not running";
+
+    m_ofFile.close();
+    m_bRunning = false;
+
+    Debug::log(LOG, "Render benchmark stopped after %i frames", m_iFrames);
+
+    return getFormat("ok, %i frames written to %s", m_iFrames, m_szPath.c_str());
+}
+
+void CRenderBenchmark::recordFrame(SMonitor* pMonitor, float renderMs, float tickMs, int damagePixels, int damageCalls, bool cursorOnly) {
+    if (!m_bRunning)
+        return;
+
+    const auto PMONITORDATA = &g_pHyprOpenGL->m_mMonitorRenderResources[pMonitor];
+    const float TIMEMS = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - m_tpStart).count() / 1000.f;
+
+    m_ofFile << getFormat("%.3f,%s,%.2f,%i,%.3f,%i,%i,%i,%i,%i,%i,%i,%.3f\n", TIMEMS, pMonitor->szName.c_str(), pMonitor->scale, pMonitor->framesRendered, renderMs, (int)cursorOnly,
+                          PMONITORDATA->glCallsIssued, PMONITORDATA->glDrawCalls, damagePixels, (int)(pMonitor->vecPixelSize.x * pMonitor->vecPixelSize.y), g_pXWaylandManager->m_iConfiguresSent, damageCalls,
+                          tickMs);
+
+    m_iFrames++;
+}
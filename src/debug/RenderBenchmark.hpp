@@ -0,0 +1,25 @@
+#pragma once
+
+#include "../defines.hpp"
+#include "../helpers/Monitor.hpp"
+#include <fstream>
+
+// Writes a CSV line for every rendered frame while running,
+// driven by hyprctl benchmark and bench/run.sh
+class CRenderBenchmark {
+public:
+    std::string start(const std::string& path);
+    std::string stop();
+
+    void        recordFrame(SMonitor*, float renderMs, float tickMs, int damagePixels, int damageCalls, bool cursorOnly);
+
+    bool        m_bRunning = false;
+
+private:
+    std::ofstream   m_ofFile;
+    std::string     m_szPath = "";
+    int             m_iFrames = 0;
+    std::chrono::steady_clock::time_point m_tpStart;
+};
+
+inline std::unique_ptr<CRenderBenchmark> g_pRenderBenchmark;
@@ -88,6 +88,7 @@ namespace Events {
     // Monitor part 2 the sequel
     DYNLISTENFUNC(monitorFrame);
     DYNLISTENFUNC(monitorDestroy);
+    DYNLISTENFUNC(monitorPresent);
 
     // XWayland
     LISTENER(readyXWayland);
@@ -123,6 +123,9 @@ void Events::listener_mapLayerSurface(void* owner, void* data) {
     wlr_box geomFixed = {layersurface->geometry.x + PMONITOR->vecPosition.x, layersurface->geometry.y + PMONITOR->vecPosition.y, layersurface->geometry.width, layersurface->geometry.height};
     g_pHyprRenderer->damageBox(&geomFixed);
 
+    if (layersurface->layer <= ZWLR_LAYER_SHELL_V1_LAYER_BOTTOM)
+        g_pHyprOpenGL->markBlurDirtyForMonitor(PMONITOR);
+
     layersurface->alpha.setValue(0);
     layersurface->alpha = 255.f;
     layersurface->readyToDelete = false;
@@ -161,6 +164,9 @@ void Events::listener_unmapLayerSurface(void* owner, void* data) {
     wlr_box geomFixed = {layersurface->geometry.x + PMONITOR->vecPosition.x, layersurface->geometry.y + PMONITOR->vecPosition.y, layersurface->geometry.width, layersurface->geometry.height};
     g_pHyprRenderer->damageBox(&geomFixed);
 
+    if (layersurface->layer <= ZWLR_LAYER_SHELL_V1_LAYER_BOTTOM)
+        g_pHyprOpenGL->markBlurDirtyForMonitor(PMONITOR);
+
     geomFixed = {layersurface->geometry.x + (int)PMONITOR->vecPosition.x, layersurface->geometry.y + (int)PMONITOR->vecPosition.y, (int)layersurface->layerSurface->surface->current.width, (int)layersurface->layerSurface->surface->current.height};
     g_pHyprRenderer->damageBox(&geomFixed);
 
@@ -182,6 +188,14 @@ void Events::listener_commitLayerSurface(void* owner, void* data) {
     wlr_box geomFixed = {layersurface->geometry.x + PMONITOR->vecPosition.x, layersurface->geometry.y + PMONITOR->vecPosition.y, layersurface->geometry.width, layersurface->geometry.height};
     g_pHyprRenderer->damageBox(&geomFixed);
 
+    // the background changed, the cached blur is invalid
+    if (layersurface->layer <= ZWLR_LAYER_SHELL_V1_LAYER_BOTTOM) {
+        g_pHyprOpenGL->markBlurDirtyForMonitor(PMONITOR);
+
+        if ((uint64_t)layersurface->monitorID != PMONITOR->ID)
+            g_pHyprOpenGL->markBlurDirtyForMonitor(g_pCompositor->getMonitorFromID(layersurface->monitorID));
+    }
+
     // fix if it changed its mon
     if ((uint64_t)layersurface->monitorID != PMONITOR->ID) {
         const auto POLDMON = g_pCompositor->getMonitorFromID(layersurface->monitorID);
@@ -199,6 +213,9 @@ void Events::listener_commitLayerSurface(void* owner, void* data) {
             PMONITOR->m_aLayerSurfaceLists[layersurface->layer].remove(layersurface);
             PMONITOR->m_aLayerSurfaceLists[layersurface->layerSurface->current.layer].push_back(layersurface);
             layersurface->layer = layersurface->layerSurface->current.layer;
+
+            if (layersurface->layer <= ZWLR_LAYER_SHELL_V1_LAYER_BOTTOM)
+                g_pHyprOpenGL->markBlurDirtyForMonitor(PMONITOR);
         }
 
         g_pLayoutManager->getCurrentLayout()->recalculateMonitor(PMONITOR->ID);
@@ -15,7 +15,43 @@
 //                                                           //
 // --------------------------------------------------------- //
 
-SMonitor* pMostHzMonitor = nullptr;
+static long timespecDiffNs(const timespec& a, const timespec& b) {
+    return (a.tv_sec - b.tv_sec) * 1000000000L + (a.tv_nsec - b.tv_nsec);
+}
+
+// when the frame we're about to render will be on screen, from the last presentation
+static timespec predictPresentation(SMonitor* pMonitor, const timespec& now) {
+    const long REFRESHNS = pMonitor->presentRefreshNs > 0 ? pMonitor->presentRefreshNs : (long)(1000000000.f / pMonitor->refreshRate);
+
+    long nsUntil = REFRESHNS;
+    if (pMonitor->lastPresentTime.tv_sec != 0) {
+        const long SINCELAST = timespecDiffNs(now, pMonitor->lastPresentTime);
+        nsUntil = REFRESHNS - (SINCELAST % REFRESHNS);
+    }
+
+    timespec predicted = now;
+    predicted.tv_nsec += nsUntil;
+    predicted.tv_sec += predicted.tv_nsec / 1000000000L;
+    predicted.tv_nsec %= 1000000000L;
+
+    return predicted;
+}
+
+int handleLateLatch(void* data);
+
+// render time we can expect from the last frames, with some headroom (90th percentile)
+static float predictRenderTimeMs(SMonitor* pMonitor) {
+    const auto COUNT = std::min(pMonitor->renderTimesCount, pMonitor->renderTimesMs.size());
+
+    if (COUNT == 0)
+        return 0;
+
+    std::vector<float> times(pMonitor->renderTimesMs.begin(), pMonitor->renderTimesMs.begin() + COUNT);
+    const auto NTH = times.begin() + (size_t)(COUNT * 0.9f);
+    std::nth_element(times.begin(), NTH, times.end());
+
+    return *NTH;
+}
 
 void Events::listener_change(wl_listener* listener, void* data) {
     // layout got changed, let's update monitors.
@@ -42,6 +78,8 @@ void Events::listener_change(wl_listener* listener, void* data) {
     }
 
     wlr_output_manager_v1_set_configuration(g_pCompositor->m_sWLROutputMgr, CONFIG);
+
+    g_pCompositor->m_sMonitorLayoutIndex.rebuild(g_pCompositor->m_lMonitors);
 }
 
 void Events::listener_newOutput(wl_listener* listener, void* data) {
@@ -95,6 +133,9 @@ void Events::listener_newOutput(wl_listener* listener, void* data) {
 
     PNEWMONITOR->hyprListener_monitorFrame.initCallback(&OUTPUT->events.frame, &Events::listener_monitorFrame, PNEWMONITOR);
     PNEWMONITOR->hyprListener_monitorDestroy.initCallback(&OUTPUT->events.destroy, &Events::listener_monitorDestroy, PNEWMONITOR);
+    PNEWMONITOR->hyprListener_monitorPresent.initCallback(&OUTPUT->events.present, &Events::listener_monitorPresent, PNEWMONITOR);
+
+    PNEWMONITOR->renderTimer = wl_event_loop_add_timer(wl_display_get_event_loop(g_pCompositor->m_sWLDisplay), &handleLateLatch, PNEWMONITOR);
 
     wlr_output_enable(OUTPUT, 1);
 
@@ -140,10 +181,6 @@ void Events::listener_newOutput(wl_listener* listener, void* data) {
     g_pCompositor->deactivateAllWLRWorkspaces(PNEWWORKSPACE->m_pWlrHandle);
     PNEWWORKSPACE->setActive(true);
 
-    if (!pMostHzMonitor || monitorRule.refreshRate > pMostHzMonitor->refreshRate)
-        pMostHzMonitor = PNEWMONITOR;
-    //
-
     if (!g_pCompositor->m_pLastMonitor) // set the last monitor if it isnt set yet
         g_pCompositor->m_pLastMonitor = PNEWMONITOR;
 
@@ -153,8 +190,8 @@ void Events::listener_newOutput(wl_listener* listener, void* data) {
     g_pCompositor->m_bReadyToProcess = true;
 }
 
-void Events::listener_monitorFrame(void* owner, void* data) {
-    SMonitor* const PMONITOR = (SMonitor*)owner;
+static void renderMonitor(SMonitor* const PMONITOR) {
+    PMONITOR->renderTimerPending = false;
 
     static std::chrono::high_resolution_clock::time_point startRender = std::chrono::high_resolution_clock::now();
     static std::chrono::high_resolution_clock::time_point startRenderOverlay = std::chrono::high_resolution_clock::now();
@@ -165,20 +202,10 @@ void Events::listener_monitorFrame(void* owner, void* data) {
         g_pDebugOverlay->frameData(PMONITOR);
     }
 
-    // Hack: only check when monitor with top hz refreshes, saves a bit of resources.
-    // This is for stuff that should be run every frame
-    if (PMONITOR->ID == pMostHzMonitor->ID) {
-        g_pCompositor->sanityCheckWorkspaces();
-        g_pAnimationManager->tick();
-        g_pCompositor->cleanupFadingOut();
-
-        HyprCtl::tickHyprCtl(); // so that we dont get that race condition multithread bullshit
+    // workspaces, fading out windows etc. don't belong to any monitor, they get their own tick
+    g_pCompositor->scheduleHousekeeping();
 
-        g_pConfigManager->dispatchExecOnce(); // We exec-once when at least one monitor starts refreshing, meaning stuff has init'd
-
-        if (g_pConfigManager->m_bWantsMonitorReload)
-            g_pConfigManager->performMonitorReload();
-    }
+    g_pConfigManager->dispatchExecOnce(); // We exec-once when at least one monitor starts refreshing, meaning stuff has init'd
 
     if (PMONITOR->needsFrameSkip) {
         PMONITOR->needsFrameSkip = false;
@@ -190,6 +217,25 @@ void Events::listener_monitorFrame(void* owner, void* data) {
     timespec now;
     clock_gettime(CLOCK_MONOTONIC, &now);
 
+    // sample the animations for when this frame will actually be shown,
+    // before getting the damage, as they damage what they move
+    PMONITOR->predictedPresentTime = predictPresentation(PMONITOR, now);
+    // steady_clock is CLOCK_MONOTONIC, so the prediction can be used as is
+    const auto PRESENTAT = std::chrono::steady_clock::time_point(std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+        std::chrono::seconds(PMONITOR->predictedPresentTime.tv_sec) + std::chrono::nanoseconds(PMONITOR->predictedPresentTime.tv_nsec)));
+    g_pAnimationManager->tick(PRESENTAT, PMONITOR);
+
+    timespec tickEnd;
+    clock_gettime(CLOCK_MONOTONIC, &tickEnd);
+    const float TICKMS = timespecDiffNs(tickEnd, now) / 1000000.f;
+
+    // whatever the ticks and input since the last frame wanted to resize, once
+    g_pXWaylandManager->flushWindowConfigures(PMONITOR);
+
+    // has to be before the frame, it renders on its own
+    g_pHyprRenderer->updateWorkspaceSnapshots(PMONITOR);
+    g_pThumbnailManager->updateForMonitor(PMONITOR);
+
     // check the damage
     pixman_region32_t damage;
     bool hasChanged;
@@ -207,55 +253,113 @@ void Events::listener_monitorFrame(void* owner, void* data) {
         return;
     }
 
+    // a full render sends them anyway
+    const bool WANTSFRAMECALLBACKS = PMONITOR->wantsFrameCallbacks;
+    PMONITOR->wantsFrameCallbacks = false;
+
     if (!hasChanged && DTMODE != DAMAGE_TRACKING_NONE) {
         pixman_region32_fini(&damage);
         wlr_output_rollback(PMONITOR->output);
-        wlr_output_schedule_frame(PMONITOR->output); // we update shit at the monitor's Hz so we need to schedule frames because rollback wont
+
+        if (WANTSFRAMECALLBACKS)
+            g_pHyprRenderer->sendFrameCallbacks(PMONITOR, &now);
+
+        if (g_pConfigManager->getInt("debug:overlay") == 1)
+            wlr_output_schedule_frame(PMONITOR->output); // the overlay wants to be updated every frame
+
         return;
     }
 
-    // if we have no tracking or full tracking, invalidate the entire monitor
-    if (DTMODE == DAMAGE_TRACKING_NONE || DTMODE == DAMAGE_TRACKING_MONITOR) {
-        pixman_region32_union_rect(&damage, &damage, 0, 0, (int)PMONITOR->vecTransformedSize.x, (int)PMONITOR->vecTransformedSize.y);
+    // before it gets expanded, for the benchmark
+    int damagePixels = 0;
+    if (g_pRenderBenchmark->m_bRunning) {
+        int rectsNum = 0;
+        const auto RECTS = pixman_region32_rectangles(&damage, &rectsNum);
+        for (int i = 0; i < rectsNum; ++i)
+            damagePixels += (RECTS[i].x2 - RECTS[i].x1) * (RECTS[i].y2 - RECTS[i].y1);
+    }
+
+    // nothing but the software cursor moved (wlr damages that itself), or a screencopy client wants a frame,
+    // the primary FB still has the rest of the last frame, so copy the damage from it and skip the clients and blur entirely.
+    // Without damage tracking too, it's about where things changed, not whether they did.
+    // Drag icons follow the cursor without damage, and the overlay draws every frame.
+    const bool SCENEDAMAGE = PMONITOR->hasSceneDamage;
+    const bool CURSORONLY = !SCENEDAMAGE && !g_pInputManager->m_sDrag.dragIcon && g_pConfigManager->getInt("debug:overlay") != 1 &&
+        g_pHyprOpenGL->canReusePrimaryFB(PMONITOR) && !g_pHyprOpenGL->preBlurQueued(PMONITOR);
+    PMONITOR->hasSceneDamage = false;
+
+    const int DAMAGECALLS = PMONITOR->damageCalls;
+    PMONITOR->damageCalls = 0;
+
+    PMONITOR->framesRendered++;
+
+    if (CURSORONLY) {
+        PMONITOR->framesCursorOnly++;
+
+        if (DTMODE != DAMAGE_TRACKING_FULL)
+            pixman_region32_union_rect(&damage, &damage, 0, 0, (int)PMONITOR->vecTransformedSize.x, (int)PMONITOR->vecTransformedSize.y);
 
         pixman_region32_copy(&g_pHyprOpenGL->m_rOriginalDamageRegion, &damage);
-    } else {
 
-        // if we use blur we need to expand the damage for proper blurring
-        if (g_pConfigManager->getInt("decoration:blur") == 1) {
-            // TODO: can this be optimized?
-            const auto BLURSIZE = g_pConfigManager->getInt("decoration:blur_size");
-            const auto BLURPASSES = g_pConfigManager->getInt("decoration:blur_passes");
+        g_pHyprOpenGL->begin(PMONITOR, &damage);
+        g_pHyprOpenGL->end();
 
-            const auto BLURRADIUS = BLURSIZE * pow(2, BLURPASSES); // is this 2^pass? I don't know but it works... I think.
+        if (WANTSFRAMECALLBACKS)
+            g_pHyprRenderer->sendFrameCallbacks(PMONITOR, &now);
+    } else {
+        // whatever a snapshot or thumbnail drew over in the primary FB
+        g_pHyprOpenGL->repairPrimaryFB(PMONITOR, &damage);
 
-            pixman_region32_copy(&g_pHyprOpenGL->m_rOriginalDamageRegion, &damage);
+        // if we have no tracking or full tracking, invalidate the entire monitor
+        if (DTMODE == DAMAGE_TRACKING_NONE || DTMODE == DAMAGE_TRACKING_MONITOR) {
+            pixman_region32_union_rect(&damage, &damage, 0, 0, (int)PMONITOR->vecTransformedSize.x, (int)PMONITOR->vecTransformedSize.y);
 
-            // now, prep the damage, get the extended damage region
-            wlr_region_expand(&damage, &damage, BLURRADIUS);                                                   // expand for proper blurring
-        } else {
             pixman_region32_copy(&g_pHyprOpenGL->m_rOriginalDamageRegion, &damage);
+        } else {
+
+            // if we use blur we need to expand the damage for proper blurring
+            if (g_pConfigManager->getInt("decoration:blur") == 1) {
+                // TODO: can this be optimized?
+                const auto BLURSIZE = g_pConfigManager->getInt("decoration:blur_size");
+                const auto BLURPASSES = g_pConfigManager->getInt("decoration:blur_passes");
+
+                const auto BLURRADIUS = BLURSIZE * pow(2, BLURPASSES); // is this 2^pass? I don't know but it works... I think.
+
+                pixman_region32_copy(&g_pHyprOpenGL->m_rOriginalDamageRegion, &damage);
+
+                // now, prep the damage, get the extended damage region
+                wlr_region_expand(&damage, &damage, BLURRADIUS);                                                   // expand for proper blurring
+            } else {
+                pixman_region32_copy(&g_pHyprOpenGL->m_rOriginalDamageRegion, &damage);
+            }
         }
-    }
 
-    // TODO: this is getting called with extents being 0,0,0,0 should it be?
-    // potentially can save on resources.
+        // the cached blur of the background is going to be redone this frame,
+        // we need the entire background rendered for that.
+        if (g_pHyprOpenGL->preBlurQueued(PMONITOR))
+            pixman_region32_union_rect(&damage, &damage, 0, 0, (int)PMONITOR->vecTransformedSize.x, (int)PMONITOR->vecTransformedSize.y);
+
+        // TODO: this is getting called with extents being 0,0,0,0 should it be?
+        // potentially can save on resources.
 
-    g_pHyprOpenGL->begin(PMONITOR, &damage);
-    g_pHyprOpenGL->clear(CColor(100, 11, 11, 255));
-    g_pHyprOpenGL->clearWithTex(); // will apply the hypr "wallpaper"
+        g_pHyprOpenGL->begin(PMONITOR, &damage);
+        g_pHyprOpenGL->clear(CColor(100, 11, 11, 255));
+        g_pHyprOpenGL->clearWithTex(); // will apply the hypr "wallpaper"
 
-    g_pHyprRenderer->renderAllClientsForMonitor(PMONITOR->ID, &now);
+        g_pHyprRenderer->renderAllClientsForMonitor(PMONITOR->ID, &now);
 
-    // if correct monitor draw hyprerror
-    if (PMONITOR->ID == 0)
-        g_pHyprError->draw();
+        // if correct monitor draw hyprerror
+        if (PMONITOR->ID == 0)
+            g_pHyprError->draw();
 
-    // for drawing the debug overlay
-    if (PMONITOR->ID == 0 && g_pConfigManager->getInt("debug:overlay") == 1) {
-        startRenderOverlay = std::chrono::high_resolution_clock::now();
-        g_pDebugOverlay->draw();
-        endRenderOverlay = std::chrono::high_resolution_clock::now();
+        // for drawing the debug overlay
+        if (PMONITOR->ID == 0 && g_pConfigManager->getInt("debug:overlay") == 1) {
+            startRenderOverlay = std::chrono::high_resolution_clock::now();
+            g_pDebugOverlay->draw();
+            endRenderOverlay = std::chrono::high_resolution_clock::now();
+        }
+
+        g_pHyprOpenGL->end();
     }
 
     wlr_renderer_begin(g_pCompositor->m_sWLRRenderer, PMONITOR->vecPixelSize.x, PMONITOR->vecPixelSize.y);
@@ -264,8 +368,6 @@ void Events::listener_monitorFrame(void* owner, void* data) {
 
     wlr_renderer_end(g_pCompositor->m_sWLRRenderer);
 
-    g_pHyprOpenGL->end();
-
     // calc frame damage
     pixman_region32_t frameDamage;
     pixman_region32_init(&frameDamage);
@@ -273,16 +375,31 @@ void Events::listener_monitorFrame(void* owner, void* data) {
     const auto TRANSFORM = wlr_output_transform_invert(PMONITOR->output->transform);
     wlr_region_transform(&frameDamage, &PMONITOR->damage->current, TRANSFORM, (int)PMONITOR->vecTransformedSize.x, (int)PMONITOR->vecTransformedSize.y);
 
-    if (DTMODE == DAMAGE_TRACKING_NONE || DTMODE == DAMAGE_TRACKING_MONITOR)
+    // this is what screencopy's copy_with_damage hands out, so it's what changed on screen, not what we redrew.
+    // Without tracking that's everything, unless nothing but the cursor changed
+    if ((DTMODE == DAMAGE_TRACKING_NONE || DTMODE == DAMAGE_TRACKING_MONITOR) && SCENEDAMAGE)
         pixman_region32_union_rect(&frameDamage, &frameDamage, 0, 0, (int)PMONITOR->vecTransformedSize.x, (int)PMONITOR->vecTransformedSize.y);
 
     wlr_output_set_damage(PMONITOR->output, &frameDamage);
     pixman_region32_fini(&frameDamage);
     pixman_region32_fini(&damage);
 
+    // remember what this frame is made of, for the latency in listener_monitorPresent
+    const auto LASTINPUT = g_pInputManager->m_tLastInputTime;
+    PMONITOR->frameInputTime = timespecDiffNs(LASTINPUT, PMONITOR->lastRenderStart) > 0 ? LASTINPUT : timespec{0, 0};
+    PMONITOR->lastRenderStart = now;
+
     wlr_output_commit(PMONITOR->output);
 
-    wlr_output_schedule_frame(PMONITOR->output);
+    timespec renderEnd;
+    clock_gettime(CLOCK_MONOTONIC, &renderEnd);
+    const float RENDERMS = timespecDiffNs(renderEnd, now) / 1000000.f;
+    PMONITOR->renderTimesMs[PMONITOR->renderTimesCount++ % PMONITOR->renderTimesMs.size()] = RENDERMS;
+
+    g_pRenderBenchmark->recordFrame(PMONITOR, RENDERMS, TICKMS, damagePixels, DAMAGECALLS, CURSORONLY);
+
+    if (g_pConfigManager->getInt("debug:overlay") == 1)
+        wlr_output_schedule_frame(PMONITOR->output);
 
     if (g_pConfigManager->getInt("debug:overlay") == 1) {
         const float µs = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::high_resolution_clock::now() - startRender).count() / 1000.f;
@@ -296,6 +413,73 @@ void Events::listener_monitorFrame(void* owner, void* data) {
     }
 }
 
+int handleLateLatch(void* data) {
+    renderMonitor((SMonitor*)data);
+
+    return 0;
+}
+
+void Events::listener_monitorFrame(void* owner, void* data) {
+    SMonitor* const PMONITOR = (SMonitor*)owner;
+
+    // the frame is already coming
+    if (PMONITOR->renderTimerPending)
+        return;
+
+    // late latching: instead of rendering right after the vblank, render as late as we can
+    // while still making the next one, so that input coming in meanwhile makes it in.
+    // with VRR there's no fixed vblank to aim for.
+    if (g_pConfigManager->getInt("general:late_latch") == 1 && PMONITOR->renderTimesCount > 0 && PMONITOR->output->adaptive_sync_status != WLR_OUTPUT_ADAPTIVE_SYNC_ENABLED) {
+        timespec now;
+        clock_gettime(CLOCK_MONOTONIC, &now);
+
+        const float UNTILPRESENTMS = timespecDiffNs(predictPresentation(PMONITOR, now), now) / 1000000.f;
+        const float DELAYMS = UNTILPRESENTMS - predictRenderTimeMs(PMONITOR) - g_pConfigManager->getFloat("general:late_latch_margin");
+
+        PMONITOR->lateLatchDelayMs = std::max(0, (int)DELAYMS);
+
+        if (PMONITOR->lateLatchDelayMs >= 1) {
+            PMONITOR->renderTimerPending = true;
+            wl_event_source_timer_update(PMONITOR->renderTimer, PMONITOR->lateLatchDelayMs);
+            return;
+        }
+    } else {
+        PMONITOR->lateLatchDelayMs = 0;
+    }
+
+    renderMonitor(PMONITOR);
+}
+
+void Events::listener_monitorPresent(void* owner, void* data) {
+    SMonitor* const PMONITOR = (SMonitor*)owner;
+    const auto E = (wlr_output_event_present*)data;
+
+    if (!E->presented || !E->when)
+        return;
+
+    if (g_pConfigManager->getInt("debug:log_presentation") == 1) {
+        // how far the animations were sampled from when they were actually shown,
+        // and the interval between presentations. Both should be stable for smooth animations.
+        const float SINCELASTMS = PMONITOR->lastPresentTime.tv_sec == 0 ? 0.f : timespecDiffNs(*E->when, PMONITOR->lastPresentTime) / 1000000.f;
+        const float PREDICTIONERRMS = PMONITOR->predictedPresentTime.tv_sec == 0 ? 0.f : timespecDiffNs(*E->when, PMONITOR->predictedPresentTime) / 1000000.f;
+
+        Debug::log(LOG, "Presentation on %s: seq %u, %.3fms since last, sampled %.3fms off, refresh %.3fms", PMONITOR->szName.c_str(), E->seq, SINCELASTMS, PREDICTIONERRMS, E->refresh / 1000000.f);
+    }
+
+    PMONITOR->lastPresentTime = *E->when;
+    PMONITOR->presentRefreshNs = E->refresh;
+
+    // rolling averages of the latency, shown in hyprctl latency
+    const float RENDERTOPRESENTMS = timespecDiffNs(*E->when, PMONITOR->lastRenderStart) / 1000000.f;
+    PMONITOR->renderToPresentMs = PMONITOR->renderToPresentMs == 0 ? RENDERTOPRESENTMS : PMONITOR->renderToPresentMs * 0.9f + RENDERTOPRESENTMS * 0.1f;
+
+    if (PMONITOR->frameInputTime.tv_sec != 0) {
+        const float INPUTTOPRESENTMS = timespecDiffNs(*E->when, PMONITOR->frameInputTime) / 1000000.f;
+        PMONITOR->inputToPresentMs = PMONITOR->inputToPresentMs == 0 ? INPUTTOPRESENTMS : PMONITOR->inputToPresentMs * 0.9f + INPUTTOPRESENTMS * 0.1f;
+        PMONITOR->frameInputTime = {0, 0};
+    }
+}
+
 void Events::listener_monitorDestroy(void* owner, void* data) {
     const auto OUTPUT = (wlr_output*)data;
 
@@ -349,20 +533,12 @@ void Events::listener_monitorDestroy(void* owner, void* data) {
 
     g_pEventManager->postEvent(SHyprIPCEvent("monitorremoved", pMonitor->szName));
 
-    g_pCompositor->m_lMonitors.remove(*pMonitor);
+    if (pMonitor->renderTimer)
+        wl_event_source_remove(pMonitor->renderTimer);
 
-    // update the pMostHzMonitor
-    if (pMostHzMonitor == pMonitor) {
-        int mostHz = 0;
-        SMonitor* pMonitorMostHz = nullptr;
+    g_pHyprOpenGL->destroyMonitorResources(pMonitor);
 
-        for (auto& m : g_pCompositor->m_lMonitors) {
-            if (m.refreshRate > mostHz) {
-                pMonitorMostHz = &m;
-                mostHz = m.refreshRate;
-            }
-        }
+    g_pCompositor->m_lMonitors.remove(*pMonitor);
 
-        pMostHzMonitor = pMonitorMostHz;
-    }
+    g_pCompositor->m_sMonitorLayoutIndex.rebuild(g_pCompositor->m_lMonitors);
 }
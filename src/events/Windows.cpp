@@ -31,6 +31,7 @@ void Events::listener_mapWindow(void* owner, void* data) {
     PWINDOW->m_iWorkspaceID = PMONITOR->specialWorkspaceOpen ? SPECIAL_WORKSPACE_ID : PMONITOR->activeWorkspace;
     PWINDOW->m_bIsMapped = true;
     PWINDOW->m_bReadyToDelete = false;
+    g_pHyprRenderer->invalidateRenderList(); // covers the workspace changes below too
     PWINDOW->m_bFadingOut = false;
     PWINDOW->m_szTitle = g_pXWaylandManager->getTitle(PWINDOW);
     PWINDOW->m_fAlpha = 255.f;
@@ -47,6 +48,7 @@ void Events::listener_mapWindow(void* owner, void* data) {
 
     if (!PWINDOWSURFACE) {
         g_pCompositor->m_lWindows.remove(*PWINDOW);
+        g_pHyprRenderer->invalidateRenderList();
         return;
     }
 
@@ -322,6 +324,13 @@ void Events::listener_commitWindow(void* owner, void* data) {
         return;
 
     // Debug::log(LOG, "Window %x committed", PWINDOW); // SPAM!
+
+    // might've been the ack a held configure is waiting for
+    if (PWINDOW->m_bConfigureQueued) {
+        const auto PMONITOR = g_pCompositor->getMonitorFromID(PWINDOW->m_iMonitorID);
+        if (PMONITOR)
+            wlr_output_schedule_frame(PMONITOR->output);
+    }
 }
 
 void Events::listener_destroyWindow(void* owner, void* data) {
@@ -405,14 +414,14 @@ void Events::listener_configureX11(void* owner, void* data) {
     g_pHyprRenderer->damageWindow(PWINDOW);
 
     if (!PWINDOW->m_bIsFloating) {
-        g_pXWaylandManager->setWindowSize(PWINDOW, PWINDOW->m_vRealSize.vec());
+        g_pXWaylandManager->setWindowSize(PWINDOW, PWINDOW->m_vRealSize.vec(), true);
         g_pInputManager->refocus();
         g_pHyprRenderer->damageWindow(PWINDOW);
         return;
     }
 
     if (!PWINDOW->m_uSurface.xwayland->mapped) {
-        wlr_xwayland_surface_configure(PWINDOW->m_uSurface.xwayland, E->x, E->y, E->width, E->height);
+        g_pXWaylandManager->configureXWaylandWindow(PWINDOW, Vector2D(E->x, E->y), Vector2D(E->width, E->height));
         return;
     }
 
@@ -421,7 +430,8 @@ void Events::listener_configureX11(void* owner, void* data) {
     PWINDOW->m_vPosition = PWINDOW->m_vRealPosition.vec();
     PWINDOW->m_vSize = PWINDOW->m_vRealSize.vec();
 
-    wlr_xwayland_surface_configure(PWINDOW->m_uSurface.xwayland, E->x, E->y, E->width, E->height);
+    g_pXWaylandManager->configureXWaylandWindow(PWINDOW, Vector2D(E->x, E->y), Vector2D(E->width, E->height));
+    PWINDOW->m_bConfigureQueued = false;
 
     g_pCompositor->moveWindowToTop(PWINDOW);
 
@@ -5,7 +5,7 @@ CAnimatedVariable::CAnimatedVariable() {
     ; // dummy var
 }
 
-void CAnimatedVariable::create(ANIMATEDVARTYPE type, float* speed, int64_t* enabled, std::string* pBezier, void* pWindow, AVARDAMAGEPOLICY policy) {
+void CAnimatedVariable::create(ANIMATEDVARTYPE type, float* speed, int64_t* enabled, int64_t* pBezier, void* pWindow, AVARDAMAGEPOLICY policy) {
     m_eVarType = type;
     m_eDamagePolicy = policy;
     m_pSpeed = speed;
@@ -13,12 +13,10 @@ void CAnimatedVariable::create(ANIMATEDVARTYPE type, float* speed, int64_t* enab
     m_pWindow = pWindow;
     m_pBezier = pBezier;
 
-    g_pAnimationManager->m_lAnimatedVariables.push_back(this);
-
     m_bDummy = false;
 }
 
-void CAnimatedVariable::create(ANIMATEDVARTYPE type, std::any val, float* speed, int64_t* enabled, std::string* pBezier, void* pWindow, AVARDAMAGEPOLICY policy) {
+void CAnimatedVariable::create(ANIMATEDVARTYPE type, std::any val, float* speed, int64_t* enabled, int64_t* pBezier, void* pWindow, AVARDAMAGEPOLICY policy) {
     create(type, speed, enabled, pBezier, pWindow, policy);
 
     try {
@@ -56,5 +54,13 @@ CAnimatedVariable::~CAnimatedVariable() {
 }
 
 void CAnimatedVariable::unregister() {
-    g_pAnimationManager->m_lAnimatedVariables.remove(this);
-}
\ No newline at end of file
+    g_pAnimationManager->deactivateVariable(this);
+}
+
+void CAnimatedVariable::onAnimationBegin() {
+    if (m_bDummy)
+        return;
+
+    g_pAnimationManager->activateVariable(this);
+    g_pAnimationManager->scheduleTick();
+}
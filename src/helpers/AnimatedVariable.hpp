@@ -24,8 +24,8 @@ class CAnimatedVariable {
 public:
     CAnimatedVariable(); // dummy var
 
-    void create(ANIMATEDVARTYPE, float* speed, int64_t* enabled, std::string* pBezier, void* pWindow, AVARDAMAGEPOLICY);
-    void create(ANIMATEDVARTYPE, std::any val, float* speed, int64_t* enabled, std::string* pBezier, void* pWindow, AVARDAMAGEPOLICY);
+    void create(ANIMATEDVARTYPE, float* speed, int64_t* enabled, int64_t* pBezier, void* pWindow, AVARDAMAGEPOLICY);
+    void create(ANIMATEDVARTYPE, std::any val, float* speed, int64_t* enabled, int64_t* pBezier, void* pWindow, AVARDAMAGEPOLICY);
 
     ~CAnimatedVariable();
 
@@ -70,46 +70,52 @@ public:
     void operator=(const Vector2D& v) {
         RASSERT(m_eVarType == AVARTYPE_VECTOR, "Tried to access =v of AVARTYPE %i!", m_eVarType);
         m_vGoal = v;
-        animationBegin = std::chrono::system_clock::now();
+        animationBegin = std::chrono::steady_clock::now();
         m_vBegun = m_vValue;
+        onAnimationBegin();
     }
 
     void operator=(const float& v) {
         RASSERT(m_eVarType == AVARTYPE_FLOAT, "Tried to access =f of AVARTYPE %i!", m_eVarType);
         m_fGoal = v;
-        animationBegin = std::chrono::system_clock::now();
+        animationBegin = std::chrono::steady_clock::now();
         m_fBegun = m_fValue;
+        onAnimationBegin();
     }
 
     void operator=(const CColor& v) {
         RASSERT(m_eVarType == AVARTYPE_COLOR, "Tried to access =c of AVARTYPE %i!", m_eVarType);
         m_cGoal = v;
-        animationBegin = std::chrono::system_clock::now();
+        animationBegin = std::chrono::steady_clock::now();
         m_cBegun = m_cValue;
+        onAnimationBegin();
     }
 
     // Sets the actual stored value, without affecting the goal, but resets the timer
     void setValue(const Vector2D& v) {
         RASSERT(m_eVarType == AVARTYPE_VECTOR, "Tried to access setValue(v) of AVARTYPE %i!", m_eVarType);
         m_vValue = v;
-        animationBegin = std::chrono::system_clock::now();
+        animationBegin = std::chrono::steady_clock::now();
         m_vBegun = m_vValue;
+        onAnimationBegin();
     }
 
     // Sets the actual stored value, without affecting the goal, but resets the timer
     void setValue(const float& v) {
         RASSERT(m_eVarType == AVARTYPE_FLOAT, "Tried to access setValue(f) of AVARTYPE %i!", m_eVarType);
         m_fValue = v;
-        animationBegin = std::chrono::system_clock::now();
-        m_vBegun = m_vValue;
+        animationBegin = std::chrono::steady_clock::now();
+        m_fBegun = m_fValue;
+        onAnimationBegin();
     }
 
     // Sets the actual stored value, without affecting the goal, but resets the timer
     void setValue(const CColor& v) {
         RASSERT(m_eVarType == AVARTYPE_COLOR, "Tried to access setValue(c) of AVARTYPE %i!", m_eVarType);
         m_cValue = v;
-        animationBegin = std::chrono::system_clock::now();
-        m_vBegun = m_vValue;
+        animationBegin = std::chrono::steady_clock::now();
+        m_cBegun = m_cValue;
+        onAnimationBegin();
     }
 
     // Sets the actual value and goal
@@ -170,6 +176,9 @@ public:
 
 private:
 
+    // lets the animation manager know it has to tick
+    void            onAnimationBegin();
+
     Vector2D        m_vValue = Vector2D(0,0);
     float           m_fValue = 0;
     CColor          m_cValue;
@@ -190,11 +199,13 @@ private:
     void*           m_pWorkspace = nullptr;
     void*           m_pLayer = nullptr;
 
-    std::string*    m_pBezier = nullptr;
+    int64_t*        m_pBezier = nullptr;  // curve ID, see CAnimationManager::getBezierID
 
     bool            m_bDummy = true;
 
-    std::chrono::system_clock::time_point animationBegin;
+    int             m_iActiveIndex = -1;  // slot in its type's SAnimationLanes in CAnimationManager, -1 if not animating
+
+    std::chrono::steady_clock::time_point animationBegin;
 
     ANIMATEDVARTYPE     m_eVarType      = AVARTYPE_INVALID;
     AVARDAMAGEPOLICY    m_eDamagePolicy = AVARDAMAGE_INVALID;
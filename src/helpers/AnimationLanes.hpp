@@ -0,0 +1,71 @@
+#pragma once
+
+#include "../defines.hpp"
+#include <array>
+#include <vector>
+
+class CAnimatedVariable;
+
+enum eAnimationLaneState : uint8_t {
+    LANE_IDLE = 0,  // not sampled this tick
+    LANE_DUE,
+    LANE_DONE       // reached the end, warps
+};
+
+// the per-frame state of the animating vars of one type, one lane per var, one array per component,
+// so that evaluating all of them is a few flat loops. A var's lane is its m_iActiveIndex.
+// Doubles, as Vector2D is, so positions don't lose anything on the way through. Colors don't mind.
+template <size_t COMPONENTS>
+struct SAnimationLanes {
+    std::vector<CAnimatedVariable*>             vars;
+    std::array<std::vector<double>, COMPONENTS> begun;
+    std::array<std::vector<double>, COMPONENTS> delta;  // goal - begun
+    std::array<std::vector<double>, COMPONENTS> value;
+    std::vector<float>                          progress;  // bezier y this tick
+    std::vector<uint8_t>                        state;     // eAnimationLaneState
+    std::vector<wlr_box>                        prevBox;   // for the damage, from before this tick
+
+    size_t size() const {
+        return vars.size();
+    }
+
+    void resize(size_t size) {
+        vars.resize(size);
+        for (size_t c = 0; c < COMPONENTS; ++c) {
+            begun[c].resize(size);
+            delta[c].resize(size);
+            value[c].resize(size);
+        }
+        progress.resize(size);
+        state.resize(size);
+        prevBox.resize(size);
+    }
+
+    void move(size_t from, size_t to) {
+        vars[to] = vars[from];
+        for (size_t c = 0; c < COMPONENTS; ++c) {
+            begun[c][to] = begun[c][from];
+            delta[c][to] = delta[c][from];
+            value[c][to] = value[c][from];
+        }
+        progress[to] = progress[from];
+        state[to] = state[from];
+        prevBox[to] = prevBox[from];
+    }
+
+    // value = begun + delta * progress, for every lane, not just the due ones.
+    // It's cheaper than branching and the rest don't get read
+    void evaluate() {
+        const size_t       COUNT = size();
+        const float* const PPROGRESS = progress.data();
+
+        for (size_t c = 0; c < COMPONENTS; ++c) {
+            const double* const PBEGUN = begun[c].data();
+            const double* const PDELTA = delta[c].data();
+            double* const       PVALUE = value[c].data();
+
+            for (size_t i = 0; i < COUNT; ++i)
+                PVALUE[i] = PBEGUN[i] + PDELTA[i] * PPROGRESS[i];
+        }
+    }
+};
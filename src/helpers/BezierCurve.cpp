@@ -15,23 +15,18 @@ void CBezierCurve::setup(std::vector<Vector2D>* pVec) {
 
     RASSERT(m_dPoints.size() == 4, "CBezierCurve only supports cubic beziers! (points num: %i)", m_dPoints.size());
 
-    // bake BAKEDPOINTS points for faster lookups
-    // T -> X ( / BAKEDPOINTS )
-    for (int i = 0; i < BAKEDPOINTS; ++i) {
-        m_aPointsBaked[i] = Vector2D(getXForT((i + 1) / (float)BAKEDPOINTS), getYForT((i + 1) / (float)BAKEDPOINTS));
+    // bake BAKEDPOINTS + 1 points for O(1) lookups
+    // X ( / BAKEDPOINTS ) -> T, Y
+    for (int i = 0; i <= BAKEDPOINTS; ++i) {
+        m_aTForX[i] = solveTForX(i * INVBAKEDPOINTS);
+        m_aYForX[i] = getYForT(m_aTForX[i]);
     }
 
     const auto ELAPSEDUS = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::high_resolution_clock::now() - BEGIN).count() / 1000.f;
-    const auto POINTSSIZE = m_aPointsBaked.size() * sizeof(m_aPointsBaked[0]) / 1000.f;
-
-    const auto BEGINCALC = std::chrono::high_resolution_clock::now();
-    for (float i = 0.1f; i < 1.f; i += 0.1f)
-        getYForPoint(i);
-    const auto ELAPSEDCALCAVG = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::high_resolution_clock::now() - BEGINCALC).count() / 1000.f / 10.f;
-
-    Debug::log(LOG, "Created a bezier curve, baked %i points, mem usage: %.2fkB, time to bake: %.2fµs. Estimated average calc time: %.2fµs.",
-        BAKEDPOINTS, POINTSSIZE, ELAPSEDUS, ELAPSEDCALCAVG);
+    const auto POINTSSIZE = (m_aYForX.size() + m_aTForX.size()) * sizeof(float) / 1000.f;
 
+    // how far off the lookups are and how long they take is in bench/bezier
+    Debug::log(LOG, "Created a bezier curve, baked %i points, mem usage: %.2fkB, time to bake: %.2fµs.", BAKEDPOINTS + 1, POINTSSIZE, ELAPSEDUS);
 }
 
 float CBezierCurve::getYForT(float t) {
@@ -42,31 +37,74 @@ float CBezierCurve::getXForT(float t) {
     return 3 * t * pow(1 - t, 2) * m_dPoints[1].x + 3 * pow(t, 2) * (1 - t) * m_dPoints[2].x + pow(t, 3);
 }
 
-// Todo: this probably can be done better and faster
-float CBezierCurve::getYForPoint(float x) {
-    // binary search for the range UPDOWN X
-    float upperT = 1;
+float CBezierCurve::getXDerivativeForT(float t) {
+    return 3 * pow(1 - t, 2) * m_dPoints[1].x + 6 * (1 - t) * t * (m_dPoints[2].x - m_dPoints[1].x) + 3 * pow(t, 2) * (1 - m_dPoints[2].x);
+}
+
+float CBezierCurve::solveTForX(float x) {
+    // bisection, only used when baking so it can be slow but sure
     float lowerT = 0;
-    float mid = 0.5;
+    float upperT = 1;
 
-    while(std::abs(upperT - lowerT) > INVBAKEDPOINTS) {
-        if (m_aPointsBaked[((int)(mid * (float)BAKEDPOINTS))].x > x) {
-            upperT = mid;
-        } else {
-            lowerT = mid;
-        }
+    for (int i = 0; i < 32; ++i) {
+        const float MID = (lowerT + upperT) / 2.f;
 
-        mid = (upperT + lowerT) / 2.f;
+        if (getXForT(MID) > x)
+            upperT = MID;
+        else
+            lowerT = MID;
     }
 
-    // in the name of performance i shall make a hack
-    const auto LOWERPOINT = &m_aPointsBaked[std::clamp((int)((float)BAKEDPOINTS * lowerT), 0, 199)];
-    const auto UPPERPOINT = &m_aPointsBaked[std::clamp((int)((float)BAKEDPOINTS * upperT), 0, 199)];
+    return (lowerT + upperT) / 2.f;
+}
+
+float CBezierCurve::getYForPoint(float x) {
+    if (x <= 0.f)
+        return m_aYForX[0];
+    if (x >= 1.f)
+        return m_aYForX[BAKEDPOINTS];
+
+    const float POS = x * BAKEDPOINTS;
+    const int   INDEX = std::min((int)POS, BAKEDPOINTS - 1);
 
-    const auto PERCINDELTA = (x - LOWERPOINT->x) / (UPPERPOINT->x - LOWERPOINT->x);
+    // curves can go vertical at the ends (like the default one at 0), a lerp is way off there
+    if (INDEX == 0 || INDEX == BAKEDPOINTS - 1)
+        return getYForPointExact(x);
 
-    if (std::isnan(PERCINDELTA) || std::isinf(PERCINDELTA))  // can sometimes happen for VERY small x
-        return 0.f;
+    const float FRAC = POS - INDEX;
 
-    return LOWERPOINT->y + (UPPERPOINT->y - UPPERPOINT->y) * PERCINDELTA;
-}
\ No newline at end of file
+    return m_aYForX[INDEX] + (m_aYForX[INDEX + 1] - m_aYForX[INDEX]) * FRAC;
+}
+
+float CBezierCurve::getYForPointExact(float x) {
+    if (x <= 0.f)
+        return m_aYForX[0];
+    if (x >= 1.f)
+        return m_aYForX[BAKEDPOINTS];
+
+    // the table brackets t, Newton from there, bisecting whenever it would leave the bracket
+    const float POS = x * BAKEDPOINTS;
+    const int   INDEX = std::min((int)POS, BAKEDPOINTS - 1);
+    float       lowerT = m_aTForX[INDEX];
+    float       upperT = m_aTForX[INDEX + 1];
+    float       t = lowerT + (upperT - lowerT) * (POS - INDEX);
+
+    for (int i = 0; i < 24; ++i) {
+        const float DIFF = getXForT(t) - x;
+
+        if (std::abs(DIFF) < 1e-7f)
+            break;
+
+        if (DIFF > 0)
+            upperT = t;
+        else
+            lowerT = t;
+
+        const float DERIVATIVE = getXDerivativeForT(t);
+        const float NEXT = DERIVATIVE == 0.f ? -1.f : t - DIFF / DERIVATIVE;
+
+        t = NEXT > lowerT && NEXT < upperT ? NEXT : (lowerT + upperT) / 2.f;
+    }
+
+    return getYForT(t);
+}
@@ -3,7 +3,7 @@
 #include "../defines.hpp"
 #include <deque>
 
-constexpr int BAKEDPOINTS = 200;
+constexpr int BAKEDPOINTS = 255;
 constexpr float INVBAKEDPOINTS = 1.f / BAKEDPOINTS;
 
 // an implementation of a cubic bezier curve
@@ -17,11 +17,20 @@ public:
 
     float   getYForT(float t);
     float   getXForT(float t);
+    float   getXDerivativeForT(float t);
+
+    // from the baked table, O(1)
     float   getYForPoint(float x);
+    // refines the baked one with Newton, for when it has to be exact
+    float   getYForPointExact(float x);
 
 private:
+    float   solveTForX(float x);
+
     // this INCLUDES the 0,0 and 1,1 points.
     std::deque<Vector2D>    m_dPoints;
 
-    std::array<Vector2D, BAKEDPOINTS>  m_aPointsBaked;
-};
\ No newline at end of file
+    // sampled at x = i / BAKEDPOINTS, so a lookup is an index and a lerp
+    std::array<float, BAKEDPOINTS + 1>  m_aYForX;
+    std::array<float, BAKEDPOINTS + 1>  m_aTForX;
+};
@@ -30,6 +30,34 @@ struct SMonitor {
     bool        needsFrameSkip  = false;
     wl_output_transform transform = WL_OUTPUT_TRANSFORM_NORMAL;
 
+    // presentation feedback, to know when a frame we render will be shown
+    timespec    lastPresentTime      = {0, 0};
+    timespec    predictedPresentTime = {0, 0};
+    int         presentRefreshNs     = 0; // 0 if unknown
+
+    // late latching (general:late_latch), see listener_monitorFrame
+    std::array<float, 120> renderTimesMs = {};  // ring of the last render times
+    size_t      renderTimesCount    = 0;
+    wl_event_source* renderTimer    = nullptr;
+    bool        renderTimerPending  = false;
+    int         lateLatchDelayMs    = 0;
+
+    // latency, rolling averages from the presentation feedback
+    timespec    lastRenderStart     = {0, 0};
+    timespec    frameInputTime      = {0, 0};  // newest input in the last committed frame
+    float       renderToPresentMs   = 0;
+    float       inputToPresentMs    = 0;
+
+    // set by our damage, if it stays false wlr only damaged the software cursor
+    // and the frame can be made from the primary FB, see renderMonitor
+    bool        hasSceneDamage      = true;
+    int         damageCalls         = 0;  // damage submissions since the last frame
+    int         framesRendered      = 0;
+    int         framesCursorOnly    = 0;
+
+    // something committed without damage and waits for its frame callback, see CHyprRenderer::damageSurface
+    bool        wantsFrameCallbacks = false;
+
     // for the special workspace
     bool        specialWorkspaceOpen = false;
     
@@ -41,6 +69,7 @@ struct SMonitor {
     DYNLISTENER(monitorFrame);
     DYNLISTENER(monitorDestroy);
     DYNLISTENER(monitorMode);
+    DYNLISTENER(monitorPresent);
 
     // hack: a group = workspaces on a monitor.
     // I don't really care lol :P
@@ -0,0 +1,60 @@
+#include "MonitorLayoutIndex.hpp"
+#include "Monitor.hpp"
+#include <algorithm>
+
+void CMonitorLayoutIndex::rebuild(std::list<SMonitor>& monitors) {
+    std::vector<std::pair<SMonitor*, wlr_box>> rects;
+
+    for (auto& m : monitors) {
+        if (!m.output || m.vecSize.x <= 0 || m.vecSize.y <= 0)
+            continue;
+
+        rects.push_back({&m, {(int)m.vecPosition.x, (int)m.vecPosition.y, (int)m.vecSize.x, (int)m.vecSize.y}});
+    }
+
+    rebuild(rects);
+}
+
+void CMonitorLayoutIndex::rebuild(const std::vector<std::pair<SMonitor*, wlr_box>>& rects) {
+    m_vEntries.clear();
+
+    for (auto& [pMonitor, box] : rects) {
+        SEntry entry;
+        entry.box = box;
+        entry.pMonitor = pMonitor;
+        m_vEntries.push_back(entry);
+    }
+
+    std::sort(m_vEntries.begin(), m_vEntries.end(), [](const SEntry& a, const SEntry& b) { return a.box.x < b.box.x; });
+
+    buildMaxRight(0, m_vEntries.size());
+}
+
+int CMonitorLayoutIndex::buildMaxRight(size_t lo, size_t hi) {
+    if (lo >= hi)
+        return INT32_MIN;
+
+    const size_t MID = lo + (hi - lo) / 2;
+    auto&        e = m_vEntries[MID];
+
+    e.maxRight = std::max({e.box.x + e.box.width, buildMaxRight(lo, MID), buildMaxRight(MID + 1, hi)});
+
+    return e.maxRight;
+}
+
+void CMonitorLayoutIndex::clear() {
+    m_vEntries.clear();
+}
+
+SMonitor* CMonitorLayoutIndex::monitorAt(const Vector2D& point) {
+    const wlr_box POINTBOX = {(int)std::floor(point.x), (int)std::floor(point.y), 1, 1};
+
+    SMonitor* pFound = nullptr;
+
+    forEachIntersecting(POINTBOX, [&](SMonitor* pMonitor, const wlr_box& intersection) {
+        pFound = pMonitor;
+        return true;  // the first one is enough
+    });
+
+    return pFound;
+}
@@ -0,0 +1,79 @@
+#pragma once
+
+#include "../defines.hpp"
+#include <list>
+#include <vector>
+#include <type_traits>
+
+struct SMonitor;
+
+// Monitor rects (layout coords) in an interval tree over x, so that we don't
+// have to go through every output for each point lookup / damage event.
+// A query is O((k + 1) log n), k being the monitors whose x range overlaps
+// the query's. Monitors stacked on top of each other all count towards k
+// and get filtered by y one by one, so a column of them is linear in its height.
+// With a handful of outputs this is about as fast as going through all of them,
+// bench/layoutindex has the numbers.
+// Rebuilt on layout changes (see Events::listener_change)
+class CMonitorLayoutIndex {
+public:
+    void            rebuild(std::list<SMonitor>&);
+    void            rebuild(const std::vector<std::pair<SMonitor*, wlr_box>>&);  // the monitors' rects, for bench/layoutindex
+    void            clear();
+
+    // nullptr if the point isn't on any monitor
+    SMonitor*       monitorAt(const Vector2D&);
+
+    // calls fn(SMonitor*, const wlr_box& intersection) for every monitor the box touches
+    template <typename F>
+    void            forEachIntersecting(const wlr_box& box, F&& fn) {
+        if (box.width <= 0 || box.height <= 0)
+            return;
+
+        forEachIntersectingIn(0, m_vEntries.size(), box, fn);
+    }
+
+private:
+    struct SEntry {
+        wlr_box     box;
+        SMonitor*   pMonitor = nullptr;
+        int         maxRight = 0;  // max x + width in the subtree this entry is the root of
+    };
+
+    // The entries are sorted by x, and [lo, hi) is a subtree rooted at (lo + hi) / 2.
+    // Returns false if fn asked to stop (returned true), for monitorAt.
+    template <typename F>
+    bool            forEachIntersectingIn(size_t lo, size_t hi, const wlr_box& box, F& fn) {
+        if (lo >= hi)
+            return true;
+
+        const size_t MID = lo + (hi - lo) / 2;
+        const auto&  E = m_vEntries[MID];
+
+        // nothing in this subtree reaches into the box
+        if (E.maxRight <= box.x)
+            return true;
+
+        if (!forEachIntersectingIn(lo, MID, box, fn))
+            return false;
+
+        // this one and everything right of it start right of the box
+        if (E.box.x >= box.x + box.width)
+            return true;
+
+        wlr_box intersection;
+        if (wlr_box_intersection(&intersection, &E.box, &box)) {
+            if constexpr (std::is_same_v<std::invoke_result_t<F&, SMonitor*, const wlr_box&>, bool>) {
+                if (fn(E.pMonitor, intersection))
+                    return false;
+            } else
+                fn(E.pMonitor, intersection);
+        }
+
+        return forEachIntersectingIn(MID + 1, hi, box, fn);
+    }
+
+    int             buildMaxRight(size_t lo, size_t hi);
+
+    std::vector<SEntry> m_vEntries;
+};
@@ -186,6 +186,10 @@ void Events::listener_unmapSubsurface(void* owner, void* data) {
 void Events::listener_commitSubsurface(void* owner, void* data) {
     SSurfaceTreeNode* pNode = (SSurfaceTreeNode*)owner;
 
+    // its thumbnail is stale even if it can't be seen
+    if (pNode->pWindowOwner)
+        g_pThumbnailManager->damageWorkspace(pNode->pWindowOwner->m_iWorkspaceID);
+
     // no damaging if it's not visible
     if (!g_pHyprRenderer->shouldRenderWindow(pNode->pWindowOwner)) {
         if (g_pConfigManager->getInt("debug:log_damage"))
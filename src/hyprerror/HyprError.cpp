@@ -60,17 +60,18 @@ void CHyprError::createQueued() {
 
     // copy the data to an OpenGL texture we have
     const auto DATA = cairo_image_surface_get_data(CAIROSURFACE);
-    m_tTexture.allocate();
-    glBindTexture(GL_TEXTURE_2D, m_tTexture.m_iTexID);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    m_tTexture.allocate({GPU_OWNER_COMPOSITOR, nullptr, "hyprerror"});
+    g_pHyprOpenGL->m_sGLState.bindTexture(GL_TEXTURE_2D, m_tTexture.m_iTexID);
+    g_pHyprOpenGL->m_sGLState.texParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    g_pHyprOpenGL->m_sGLState.texParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
     
     #ifndef GLES2
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_R, GL_BLUE);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_B, GL_RED);
+        g_pHyprOpenGL->m_sGLState.texParameteri(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_R, GL_BLUE);
+        g_pHyprOpenGL->m_sGLState.texParameteri(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_B, GL_RED);
     #endif
     
     glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, PMONITOR->vecSize.x, PMONITOR->vecSize.y, 0, GL_RGBA, GL_UNSIGNED_BYTE, DATA);
+    g_pHyprOpenGL->m_sGPUResources.setStorage(m_tTexture.m_iTexID, PMONITOR->vecSize, "RGBA8", 4);
 
     // delete cairo
     cairo_destroy(CAIRO);
@@ -112,4 +113,8 @@ void CHyprError::draw() {
 void CHyprError::destroy() {
     if (m_bIsCreated)
         m_bQueuedDestroy = true;
+}
+
+bool CHyprError::hasPending() {
+    return m_szQueued != "" || m_bQueuedDestroy;
 }
\ No newline at end of file
@@ -415,6 +415,7 @@ void CHyprDwindleLayout::changeWindowFloatingMode(CWindow* pWindow) {
         const auto PNEWMON = g_pCompositor->getMonitorFromVector(pWindow->m_vRealPosition.vec() + pWindow->m_vRealSize.vec() / 2.f);
         pWindow->m_iMonitorID = PNEWMON->ID;
         pWindow->m_iWorkspaceID = PNEWMON->activeWorkspace;
+        g_pHyprRenderer->invalidateRenderList();
 
         // save real pos cuz the func applies the default 5,5 mid
         const auto PSAVEDPOS = pWindow->m_vRealPosition.vec();
@@ -602,7 +603,11 @@ void CHyprDwindleLayout::onMouseMove(const Vector2D& mousePos) {
 
     if (PMONITOR) {
         DRAGGINGWINDOW->m_iMonitorID = PMONITOR->ID;
-        DRAGGINGWINDOW->m_iWorkspaceID = PMONITOR->activeWorkspace;
+
+        if (DRAGGINGWINDOW->m_iWorkspaceID != PMONITOR->activeWorkspace) {
+            DRAGGINGWINDOW->m_iWorkspaceID = PMONITOR->activeWorkspace;
+            g_pHyprRenderer->invalidateRenderList();
+        }
     }
 
     g_pHyprRenderer->damageWindow(DRAGGINGWINDOW);
@@ -1,64 +1,263 @@
 #include "AnimationManager.hpp"
 #include "../Compositor.hpp"
 
+static int wlTick(void* data) {
+    g_pAnimationManager->onTicked();
+
+    return 0;
+}
+
 CAnimationManager::CAnimationManager() {
-    std::vector<Vector2D> points = {Vector2D(0, 0.75f), Vector2D(0.15f, 1.f)};
-    m_mBezierCurves["default"].setup(&points);
+    removeAllBeziers();
+
+    pixman_region32_init(&m_rAnimationDamage);
+
+    m_pAnimationTick = wl_event_loop_add_timer(wl_display_get_event_loop(g_pCompositor->m_sWLDisplay), &wlTick, nullptr);
+}
+
+void CAnimationManager::scheduleTick() {
+    if (m_bTickScheduled)
+        return;
+
+    m_bTickScheduled = true;
+
+    // tick at the rate of the fastest monitor
+    float refreshRate = 60.f;
+    for (auto& m : g_pCompositor->m_lMonitors)
+        refreshRate = std::max(refreshRate, m.refreshRate);
+
+    wl_event_source_timer_update(m_pAnimationTick, std::max(1, (int)(1000.f / refreshRate)));
+}
+
+void CAnimationManager::onTicked() {
+    m_bTickScheduled = false;
+
+    // stuff that no monitor is going to draw still has to reach its goal
+    tick(std::chrono::steady_clock::now(), nullptr);
+    g_pXWaylandManager->flushWindowConfigures(nullptr);
+
+    // the rest is sampled by its monitor when it renders, we just need it to render
+    const auto SCHEDULEFRAME = [&](CAnimatedVariable* av) {
+        const auto PMONITOR = getMonitorForVariable(av);
+        if (PMONITOR && PMONITOR->output->enabled)
+            wlr_output_schedule_frame(PMONITOR->output);
+    };
+
+    std::for_each(m_sFloatLanes.vars.begin(), m_sFloatLanes.vars.end(), SCHEDULEFRAME);
+    std::for_each(m_sVectorLanes.vars.begin(), m_sVectorLanes.vars.end(), SCHEDULEFRAME);
+    std::for_each(m_sColorLanes.vars.begin(), m_sColorLanes.vars.end(), SCHEDULEFRAME);
+
+    // nothing left, let everything go idle until something gets a new goal
+    if (isAnimating())
+        scheduleTick();
+
+    // closed windows / layers are destroyed once they faded out
+    if (!g_pCompositor->m_lWindowsFadingOut.empty() || !g_pCompositor->m_lSurfacesFadingOut.empty())
+        g_pCompositor->scheduleHousekeeping();
+}
+
+// a component each
+static void toLane(const float& v, double* out) {
+    out[0] = v;
+}
+
+static void toLane(const Vector2D& v, double* out) {
+    out[0] = v.x;
+    out[1] = v.y;
+}
+
+static void toLane(const CColor& v, double* out) {
+    out[0] = v.r;
+    out[1] = v.g;
+    out[2] = v.b;
+    out[3] = v.a;
+}
+
+template <size_t N, typename T>
+void CAnimationManager::setLane(SAnimationLanes<N>& lanes, CAnimatedVariable* av, const T& begun, const T& goal) {
+    if (av->m_iActiveIndex == -1) {
+        av->m_iActiveIndex = lanes.size();
+        lanes.resize(lanes.size() + 1);
+        lanes.vars[av->m_iActiveIndex] = av;
+    }
+
+    double beginComponents[N], goalComponents[N];
+    toLane(begun, beginComponents);
+    toLane(goal, goalComponents);
+
+    const size_t I = av->m_iActiveIndex;
+    for (size_t c = 0; c < N; ++c) {
+        lanes.begun[c][I] = beginComponents[c];
+        lanes.delta[c][I] = goalComponents[c] - beginComponents[c];
+        lanes.value[c][I] = beginComponents[c];
+    }
+
+    lanes.progress[I] = 0;
+    lanes.state[I] = LANE_IDLE;
+}
+
+template <size_t N>
+void CAnimationManager::removeLane(SAnimationLanes<N>& lanes, CAnimatedVariable* av) {
+    // swap with the last one
+    const size_t I = av->m_iActiveIndex;
+    const size_t LAST = lanes.size() - 1;
+
+    if (I != LAST) {
+        lanes.move(LAST, I);
+        lanes.vars[I]->m_iActiveIndex = I;
+    }
+
+    lanes.resize(LAST);
+    av->m_iActiveIndex = -1;
+}
+
+template <size_t N>
+void CAnimationManager::dropFinishedLanes(SAnimationLanes<N>& lanes) {
+    size_t kept = 0;
+    for (size_t i = 0; i < lanes.size(); ++i) {
+        const auto AV = lanes.vars[i];
+
+        if (!AV->isBeingAnimated()) {
+            AV->m_iActiveIndex = -1;
+            continue;
+        }
+
+        if (kept != i)
+            lanes.move(i, kept);
+
+        AV->m_iActiveIndex = kept++;
+    }
+
+    lanes.resize(kept);
+}
+
+void CAnimationManager::activateVariable(CAnimatedVariable* av) {
+    // called on every new goal, the lane has to start from where the var is now
+    switch (av->m_eVarType) {
+        case AVARTYPE_FLOAT: setLane(m_sFloatLanes, av, av->m_fBegun, av->m_fGoal); break;
+        case AVARTYPE_VECTOR: setLane(m_sVectorLanes, av, av->m_vBegun, av->m_vGoal); break;
+        case AVARTYPE_COLOR: setLane(m_sColorLanes, av, av->m_cBegun, av->m_cGoal); break;
+        default: break;
+    }
+}
+
+void CAnimationManager::deactivateVariable(CAnimatedVariable* av) {
+    if (av->m_iActiveIndex == -1)
+        return;
+
+    switch (av->m_eVarType) {
+        case AVARTYPE_FLOAT: removeLane(m_sFloatLanes, av); break;
+        case AVARTYPE_VECTOR: removeLane(m_sVectorLanes, av); break;
+        case AVARTYPE_COLOR: removeLane(m_sColorLanes, av); break;
+        default: break;
+    }
+}
+
+bool CAnimationManager::isAnimating() {
+    return m_sFloatLanes.size() + m_sVectorLanes.size() + m_sColorLanes.size() > 0;
+}
+
+void CAnimationManager::dropFinishedVariables() {
+    dropFinishedLanes(m_sFloatLanes);
+    dropFinishedLanes(m_sVectorLanes);
+    dropFinishedLanes(m_sColorLanes);
+}
+
+SMonitor* CAnimationManager::getMonitorForVariable(CAnimatedVariable* av) {
+    if (const auto PWINDOW = (CWindow*)av->m_pWindow)
+        return g_pCompositor->getMonitorFromID(PWINDOW->m_iMonitorID);
+
+    if (const auto PWORKSPACE = (CWorkspace*)av->m_pWorkspace)
+        return g_pCompositor->getMonitorFromID(PWORKSPACE->m_iMonitorID);
+
+    if (const auto PLAYER = (SLayerSurface*)av->m_pLayer)
+        return g_pCompositor->getMonitorFromID(PLAYER->monitorID);
+
+    return nullptr;
 }
 
 void CAnimationManager::removeAllBeziers() {
-    m_mBezierCurves.clear();
+    m_vBezierCurves.clear();
+    m_mBezierIDs.clear();
 
     // add the default one
-    std::vector<Vector2D> points = {Vector2D(0, 0.75f), Vector2D(0.15f, 1.f)};
-    m_mBezierCurves["default"].setup(&points);
+    addBezierWithName("default", Vector2D(0, 0.75f), Vector2D(0.15f, 1.f));
 }
 
 void CAnimationManager::addBezierWithName(std::string name, const Vector2D& p1, const Vector2D& p2) {
+    auto IT = m_mBezierIDs.find(name);
+    if (IT == m_mBezierIDs.end()) {
+        IT = m_mBezierIDs.emplace(name, m_vBezierCurves.size()).first;
+        m_vBezierCurves.emplace_back();
+    }
+
     std::vector points = {p1, p2};
-    m_mBezierCurves[name].setup(&points);
+    m_vBezierCurves[IT->second].setup(&points);
 }
 
-void CAnimationManager::tick() {
+int CAnimationManager::getBezierID(const std::string& name) {
+    const auto IT = m_mBezierIDs.find(name);
+    return IT == m_mBezierIDs.end() ? -1 : IT->second;
+}
 
-    bool animationsDisabled = false;
+CBezierCurve* CAnimationManager::getBezier(int64_t id) {
+    if (id >= 0 && id < (int64_t)m_vBezierCurves.size())
+        return &m_vBezierCurves[id];
 
-    if (!g_pConfigManager->getInt("animations:enabled"))
-        animationsDisabled = true;
+    // unset ([[f]]) or unknown, use animations:curve
+    id = *g_pConfigManager->getCurveIDPtr("animations:curve");
+    if (id >= 0 && id < (int64_t)m_vBezierCurves.size())
+        return &m_vBezierCurves[id];
 
-    const float ANIMSPEED       = g_pConfigManager->getFloat("animations:speed");
-    const auto BORDERSIZE       = g_pConfigManager->getInt("general:border_size");
-    const auto BEZIERSTR        = g_pConfigManager->getString("animations:curve");
+    return &m_vBezierCurves[0];
+}
 
-    auto DEFAULTBEZIER = m_mBezierCurves.find(BEZIERSTR);
-    if (DEFAULTBEZIER == m_mBezierCurves.end())
-        DEFAULTBEZIER = m_mBezierCurves.find("default");
+wlr_box CAnimationManager::getVariableBox(CAnimatedVariable* av) {
+    const auto PWINDOW = (CWindow*)av->m_pWindow;
+    const auto PWORKSPACE = (CWorkspace*)av->m_pWorkspace;
+    const auto PLAYER = (SLayerSurface*)av->m_pLayer;
+
+    if (PWINDOW) {
+        const auto BORDERSIZE = g_pConfigManager->getInt("general:border_size");
+        return {(int)PWINDOW->m_vRealPosition.vec().x - BORDERSIZE - 1, (int)PWINDOW->m_vRealPosition.vec().y - BORDERSIZE - 1, (int)PWINDOW->m_vRealSize.vec().x + 2 * BORDERSIZE + 2, (int)PWINDOW->m_vRealSize.vec().y + 2 * BORDERSIZE + 2};
+    } else if (PWORKSPACE) {
+        const auto PMONITOR = g_pCompositor->getMonitorFromID(PWORKSPACE->m_iMonitorID);
+        return {(int)PMONITOR->vecPosition.x, (int)PMONITOR->vecPosition.y, (int)PMONITOR->vecSize.x, (int)PMONITOR->vecSize.y};
+    } else if (PLAYER) {
+        return PLAYER->geometry;
+    }
 
-    for (auto& av : m_lAnimatedVariables) {
-        // get speed
-        const auto SPEED = *av->m_pSpeed == 0 ? ANIMSPEED : *av->m_pSpeed;
+    return {0, 0, 0, 0};
+}
 
-        // window stuff
-        const auto PWINDOW = (CWindow*)av->m_pWindow;
-        const auto PWORKSPACE = (CWorkspace*)av->m_pWorkspace;
-        const auto PLAYER = (SLayerSurface*)av->m_pLayer;
+template <size_t N>
+void CAnimationManager::sampleLanes(SAnimationLanes<N>& lanes, const std::chrono::steady_clock::time_point& sampleTime, SMonitor* pMonitor) {
+    const bool ANIMATIONSDISABLED = !g_pConfigManager->getInt("animations:enabled");
+    const float ANIMSPEED = g_pConfigManager->getFloat("animations:speed");
+    const auto DEFAULTBEZIER = getBezier(-1);
+
+    for (size_t i = 0; i < lanes.size(); ++i) {
+        const auto AV = lanes.vars[i];
+
+        lanes.state[i] = LANE_IDLE;
+
+        if (!AV->isBeingAnimated())
+            continue;
+
+        // each monitor samples its own stuff, nullptr gets whatever isn't on an enabled one
+        const auto PVARMONITOR = getMonitorForVariable(AV);
+        if (pMonitor ? PVARMONITOR != pMonitor : PVARMONITOR && PVARMONITOR->output->enabled)
+            continue;
+
+        // before anything moves this tick
+        lanes.prevBox[i] = getVariableBox(AV);
 
-        wlr_box WLRBOXPREV = {0,0,0,0};
-        if (PWINDOW) {
-            WLRBOXPREV = {(int)PWINDOW->m_vRealPosition.vec().x - BORDERSIZE - 1, (int)PWINDOW->m_vRealPosition.vec().y - BORDERSIZE - 1, (int)PWINDOW->m_vRealSize.vec().x + 2 * BORDERSIZE + 2, (int)PWINDOW->m_vRealSize.vec().y + 2 * BORDERSIZE + 2};
-        } else if (PWORKSPACE) {
-            const auto PMONITOR = g_pCompositor->getMonitorFromID(PWORKSPACE->m_iMonitorID);
-            WLRBOXPREV = {(int)PMONITOR->vecPosition.x, (int)PMONITOR->vecPosition.y, (int)PMONITOR->vecSize.x, (int)PMONITOR->vecSize.y};
-        } else if (PLAYER) {
-            WLRBOXPREV = PLAYER->geometry;
-        }
-        
         // check if it's disabled, if so, warp
-        if (av->m_pEnabled == 0 || animationsDisabled) {
-            av->warp();
-            g_pHyprRenderer->damageBox(&WLRBOXPREV);
+        if (AV->m_pEnabled == 0 || ANIMATIONSDISABLED) {
+            AV->warp();
+            g_pHyprRenderer->damageBox(&lanes.prevBox[i]);
 
-            if (PWINDOW) {
+            if (const auto PWINDOW = (CWindow*)AV->m_pWindow) {
                 g_pHyprRenderer->damageWindow(PWINDOW);
                 // set size and pos if valid
                 if (g_pCompositor->windowValidMapped(PWINDOW))
@@ -68,119 +267,125 @@ void CAnimationManager::tick() {
             continue;
         }
 
-        // beziers are with a switch unforto
-        // TODO: maybe do something cleaner
+        const auto SPEED = *AV->m_pSpeed == 0 ? ANIMSPEED : *AV->m_pSpeed;
 
         // get the spent % (0 - 1)
-        const auto DURATIONPASSED = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now() - av->animationBegin).count();
-        const float SPENT = std::clamp((DURATIONPASSED / 100.f) / SPEED, 0.f, 1.f);
-
-        switch (av->m_eVarType) {
-            case AVARTYPE_FLOAT: {
-                if (!deltazero(av->m_fValue, av->m_fGoal)) {
-                    const auto DELTA = av->m_fGoal - av->m_fBegun;
-                    const auto BEZIER = m_mBezierCurves.find(*av->m_pBezier);
-
-                    if (BEZIER != m_mBezierCurves.end())
-                        av->m_fValue = av->m_fBegun + BEZIER->second.getYForPoint(SPENT) * DELTA;
-                    else
-                        av->m_fValue = av->m_fBegun + DEFAULTBEZIER->second.getYForPoint(SPENT) * DELTA;
-
-                    if (SPENT >= 1.f) {
-                        av->warp();
-                    }
-                } else {
-                    continue; // dont process
-                }
-                break;
-            }
-            case AVARTYPE_VECTOR: {
-                if (!deltazero(av->m_vValue, av->m_vGoal)) {
-                    const auto DELTA = av->m_vGoal - av->m_vBegun;
-                    const auto BEZIER = m_mBezierCurves.find(*av->m_pBezier);
-
-                    if (BEZIER != m_mBezierCurves.end())
-                        av->m_vValue = av->m_vBegun + DELTA * BEZIER->second.getYForPoint(SPENT);
-                    else
-                        av->m_vValue = av->m_vBegun + DELTA * DEFAULTBEZIER->second.getYForPoint(SPENT);
-
-                    if (SPENT >= 1.f) {
-                        av->warp();
-                    }
-                } else {
-                    continue;  // dont process
-                }
-                break;
-            }
-            case AVARTYPE_COLOR: {
-                if (!deltazero(av->m_cValue, av->m_cGoal)) {
-                    const auto DELTA = av->m_cGoal - av->m_cBegun;
-                    const auto BEZIER = m_mBezierCurves.find(*av->m_pBezier);
-
-                    if (BEZIER != m_mBezierCurves.end())
-                        av->m_cValue = av->m_cBegun + DELTA * BEZIER->second.getYForPoint(SPENT);
-                    else
-                        av->m_cValue = av->m_cBegun + DELTA * DEFAULTBEZIER->second.getYForPoint(SPENT);
-
-                    if (SPENT >= 1.f) {
-                        av->warp();
-                    }
-                } else {
-                    continue;  // dont process
-                }
-                break;
-            }
-            default: {
-                ;
-            }
+        const auto DURATIONPASSED = std::chrono::duration_cast<std::chrono::microseconds>(sampleTime - AV->animationBegin).count();
+        const float SPENT = std::clamp((DURATIONPASSED / 100000.f) / SPEED, 0.f, 1.f);
+
+        const auto BEZIERID = *AV->m_pBezier;
+        lanes.progress[i] = (BEZIERID >= 0 && BEZIERID < (int64_t)m_vBezierCurves.size() ? &m_vBezierCurves[BEZIERID] : DEFAULTBEZIER)->getYForPoint(SPENT);
+        lanes.state[i] = SPENT >= 1.f ? LANE_DONE : LANE_DUE;
+    }
+}
+
+template <size_t N>
+void CAnimationManager::applyLanes(SAnimationLanes<N>& lanes) {
+    // indices, as damaging / configuring can give other vars a new goal, which appends here
+    for (size_t i = 0; i < lanes.size(); ++i) {
+        if (lanes.state[i] == LANE_IDLE)
+            continue;
+
+        const auto AV = lanes.vars[i];
+
+        if (lanes.state[i] == LANE_DONE) {
+            AV->warp();
+        } else {
+            if constexpr (N == 1)
+                AV->m_fValue = lanes.value[0][i];
+            else if constexpr (N == 2)
+                AV->m_vValue = Vector2D(lanes.value[0][i], lanes.value[1][i]);
+            else
+                AV->m_cValue = CColor(lanes.value[0][i], lanes.value[1][i], lanes.value[2][i], lanes.value[3][i]);
         }
 
-        // damage the window with the damage policy
-        switch (av->m_eDamagePolicy) {
-            case AVARDAMAGE_ENTIRE: {
-                g_pHyprRenderer->damageBox(&WLRBOXPREV);
+        // a new goal from something damaged above resets the lane, don't apply it twice
+        lanes.state[i] = LANE_IDLE;
+
+        damageAnimatedVariable(AV, lanes.prevBox[i]);
+    }
+}
+
+void CAnimationManager::damageAnimatedVariable(CAnimatedVariable* av, const wlr_box& prevBox) {
+    const auto PWINDOW = (CWindow*)av->m_pWindow;
+    const auto PLAYER = (SLayerSurface*)av->m_pLayer;
+    const wlr_box WLRBOXNEW = getVariableBox(av);
 
-                if (PWINDOW) {
-                    g_pHyprRenderer->damageWindow(PWINDOW);
-                    for (auto& wd : PWINDOW->m_dWindowDecorations) {
-                        wd->updateWindow(PWINDOW);
-                    }
+    // fading background layers change what's cached below the windows
+    if (PLAYER && PLAYER->layer <= ZWLR_LAYER_SHELL_V1_LAYER_BOTTOM)
+        g_pHyprOpenGL->markBlurDirtyForMonitor(g_pCompositor->getMonitorFromID(PLAYER->monitorID));
+
+    // damage the window with the damage policy. Goes into m_rAnimationDamage,
+    // which tick() submits once, so overlapping stuff doesn't get damaged over and over
+    switch (av->m_eDamagePolicy) {
+        case AVARDAMAGE_ENTIRE: {
+            pixman_region32_union_rect(&m_rAnimationDamage, &m_rAnimationDamage, prevBox.x, prevBox.y, prevBox.width, prevBox.height);
+            pixman_region32_union_rect(&m_rAnimationDamage, &m_rAnimationDamage, WLRBOXNEW.x, WLRBOXNEW.y, WLRBOXNEW.width, WLRBOXNEW.height);
+
+            if (PWINDOW) {
+                for (auto& wd : PWINDOW->m_dWindowDecorations) {
+                    wd->updateWindow(PWINDOW);
                 }
-                break;
-            }
-            case AVARDAMAGE_BORDER: {
-                RASSERT(PWINDOW, "Tried to AVARDAMAGE_BORDER a non-window AVAR!");
-                
-                // damage only the border.
-                const auto BORDERSIZE = g_pConfigManager->getInt("general:border_size") + 1; // +1 for padding and shit
-                const auto ROUNDINGSIZE = g_pConfigManager->getInt("decoration:rounding") + 1;
-
-                // damage for old box
-                g_pHyprRenderer->damageBox(WLRBOXPREV.x - BORDERSIZE, WLRBOXPREV.y - BORDERSIZE, WLRBOXPREV.width + 2 * BORDERSIZE, BORDERSIZE + ROUNDINGSIZE);                              // top
-                g_pHyprRenderer->damageBox(WLRBOXPREV.x - BORDERSIZE, WLRBOXPREV.y - BORDERSIZE, BORDERSIZE + ROUNDINGSIZE, WLRBOXPREV.height + 2 * BORDERSIZE);                             // left
-                g_pHyprRenderer->damageBox(WLRBOXPREV.x + WLRBOXPREV.width - ROUNDINGSIZE, WLRBOXPREV.y - BORDERSIZE, BORDERSIZE + ROUNDINGSIZE, WLRBOXPREV.height + 2 * BORDERSIZE);        // right
-                g_pHyprRenderer->damageBox(WLRBOXPREV.x, WLRBOXPREV.y + WLRBOXPREV.height - ROUNDINGSIZE, WLRBOXPREV.width + 2 * BORDERSIZE, BORDERSIZE + ROUNDINGSIZE);                     // bottom
-
-                // damage for new box
-                const wlr_box WLRBOXNEW = {PWINDOW->m_vRealPosition.vec().x, PWINDOW->m_vRealPosition.vec().y, PWINDOW->m_vRealSize.vec().x, PWINDOW->m_vRealSize.vec().y};
-                g_pHyprRenderer->damageBox(WLRBOXNEW.x - BORDERSIZE, WLRBOXNEW.y - BORDERSIZE, WLRBOXNEW.width + 2 * BORDERSIZE, BORDERSIZE + ROUNDINGSIZE);                                // top
-                g_pHyprRenderer->damageBox(WLRBOXNEW.x - BORDERSIZE, WLRBOXNEW.y - BORDERSIZE, BORDERSIZE + ROUNDINGSIZE, WLRBOXNEW.height + 2 * BORDERSIZE);                               // left
-                g_pHyprRenderer->damageBox(WLRBOXNEW.x + WLRBOXNEW.width - ROUNDINGSIZE, WLRBOXNEW.y - BORDERSIZE, BORDERSIZE + ROUNDINGSIZE, WLRBOXNEW.height + 2 * BORDERSIZE);           // right
-                g_pHyprRenderer->damageBox(WLRBOXNEW.x, WLRBOXNEW.y + WLRBOXNEW.height - ROUNDINGSIZE, WLRBOXNEW.width + 2 * BORDERSIZE, BORDERSIZE + ROUNDINGSIZE);                        // bottom
-
-                break;
-            }
-            default: {
-                Debug::log(ERR, "av has damage policy INVALID???");
-                break;
             }
+            break;
         }
-        
+        case AVARDAMAGE_BORDER: {
+            RASSERT(PWINDOW, "Tried to AVARDAMAGE_BORDER a non-window AVAR!");
+
+            // damage only the border, the inside stays the same.
+            // the boxes already include the border, and the rounding eats into the window
+            const auto INSET = g_pConfigManager->getInt("general:border_size") + 1 + g_pConfigManager->getInt("decoration:rounding") + 1;
+
+            addBorderRing(prevBox, INSET);
+            if (prevBox.x != WLRBOXNEW.x || prevBox.y != WLRBOXNEW.y || prevBox.width != WLRBOXNEW.width || prevBox.height != WLRBOXNEW.height)
+                addBorderRing(WLRBOXNEW, INSET);
 
-        // set size and pos if valid, but only if damage policy entire (dont if border for example)
-        if (g_pCompositor->windowValidMapped(PWINDOW) && av->m_eDamagePolicy == AVARDAMAGE_ENTIRE)
-            g_pXWaylandManager->setWindowSize(PWINDOW, PWINDOW->m_vRealSize.goalv());
+            break;
+        }
+        default: {
+            Debug::log(ERR, "av has damage policy INVALID???");
+            break;
+        }
+    }
+
+    // set size and pos if valid, but only if damage policy entire (dont if border for example)
+    if (g_pCompositor->windowValidMapped(PWINDOW) && av->m_eDamagePolicy == AVARDAMAGE_ENTIRE)
+        g_pXWaylandManager->setWindowSize(PWINDOW, PWINDOW->m_vRealSize.goalv());
+}
+
+void CAnimationManager::addBorderRing(const wlr_box& box, int inset) {
+    pixman_region32_t ring;
+    pixman_region32_init_rect(&ring, box.x, box.y, box.width, box.height);
+
+    if (box.width > 2 * inset && box.height > 2 * inset) {
+        pixman_region32_t inside;
+        pixman_region32_init_rect(&inside, box.x + inset, box.y + inset, box.width - 2 * inset, box.height - 2 * inset);
+        pixman_region32_subtract(&ring, &ring, &inside);
+        pixman_region32_fini(&inside);
     }
+
+    pixman_region32_union(&m_rAnimationDamage, &m_rAnimationDamage, &ring);
+    pixman_region32_fini(&ring);
+}
+
+void CAnimationManager::tick(const std::chrono::steady_clock::time_point& sampleTime, SMonitor* pMonitor) {
+    // which lanes are due and how far along, then all of their values at once, then the damage
+    sampleLanes(m_sFloatLanes, sampleTime, pMonitor);
+    sampleLanes(m_sVectorLanes, sampleTime, pMonitor);
+    sampleLanes(m_sColorLanes, sampleTime, pMonitor);
+
+    m_sFloatLanes.evaluate();
+    m_sVectorLanes.evaluate();
+    m_sColorLanes.evaluate();
+
+    applyLanes(m_sFloatLanes);
+    applyLanes(m_sVectorLanes);
+    applyLanes(m_sColorLanes);
+
+    g_pHyprRenderer->damageRegion(&m_rAnimationDamage);
+    pixman_region32_clear(&m_rAnimationDamage);
+
+    dropFinishedVariables();
 }
 
 bool CAnimationManager::deltaSmallToFlip(const Vector2D& a, const Vector2D& b) {
@@ -3,8 +3,12 @@
 #include "../defines.hpp"
 #include <list>
 #include <unordered_map>
+#include <array>
+#include <vector>
 #include "../helpers/AnimatedVariable.hpp"
 #include "../helpers/BezierCurve.hpp"
+#include "../helpers/AnimationLanes.hpp"
+#include "../helpers/Monitor.hpp"
 #include "../Window.hpp"
 
 class CAnimationManager {
@@ -12,15 +16,49 @@ public:
 
     CAnimationManager();
 
-    void            tick();
+    // samples the animations of pMonitor at sampleTime (its next presentation).
+    // steady_clock, so that's CLOCK_MONOTONIC, same as the presentation timestamps
+    void            tick(const std::chrono::steady_clock::time_point& sampleTime, SMonitor* pMonitor);
+    void            scheduleTick();
+    void            onTicked();
     void            addBezierWithName(std::string, const Vector2D&, const Vector2D&);
     void            removeAllBeziers();
+    int             getBezierID(const std::string&);  // -1 if there's no such curve, the config resolves the names with this
 
     void            onWindowPostCreateClose(CWindow*, bool close = false);
 
-    std::list<CAnimatedVariable*> m_lAnimatedVariables;
+    // only the ones with a goal they haven't reached yet get a lane, tick() doesn't look at the rest.
+    // Vars join when they get a new goal and leave once they reach it.
+    void            activateVariable(CAnimatedVariable*);
+    void            deactivateVariable(CAnimatedVariable*);
+    bool            isAnimating();
 
 private:
+    SAnimationLanes<1> m_sFloatLanes;
+    SAnimationLanes<2> m_sVectorLanes;
+    SAnimationLanes<4> m_sColorLanes;
+
+    template <size_t N, typename T>
+    void            setLane(SAnimationLanes<N>&, CAnimatedVariable*, const T& begun, const T& goal);
+    template <size_t N>
+    void            removeLane(SAnimationLanes<N>&, CAnimatedVariable*);
+    template <size_t N>
+    void            dropFinishedLanes(SAnimationLanes<N>&);
+    template <size_t N>
+    void            sampleLanes(SAnimationLanes<N>&, const std::chrono::steady_clock::time_point& sampleTime, SMonitor* pMonitor);
+    template <size_t N>
+    void            applyLanes(SAnimationLanes<N>&);
+
+    void            dropFinishedVariables();
+    wlr_box         getVariableBox(CAnimatedVariable*);
+    void            damageAnimatedVariable(CAnimatedVariable*, const wlr_box& prevBox);
+    void            addBorderRing(const wlr_box&, int inset);
+
+    // everything the vars of one tick() damaged, layout coords
+    pixman_region32_t m_rAnimationDamage;
+
+    SMonitor*       getMonitorForVariable(CAnimatedVariable*);
+
     bool            deltaSmallToFlip(const Vector2D& a, const Vector2D& b);
     bool            deltaSmallToFlip(const CColor& a, const CColor& b);
     bool            deltaSmallToFlip(const float& a, const float& b);
@@ -28,7 +66,15 @@ private:
     bool            deltazero(const CColor& a, const CColor& b);
     bool            deltazero(const float& a, const float& b);
 
-    std::unordered_map<std::string, CBezierCurve> m_mBezierCurves;
+    CBezierCurve*   getBezier(int64_t id);
+
+    // indexed by ID, "default" is always 0. IDs stay the same when a curve is redefined
+    std::vector<CBezierCurve>               m_vBezierCurves;
+    std::unordered_map<std::string, int>    m_mBezierIDs;
+
+    // ticks on the event loop, only while something is animating
+    wl_event_source* m_pAnimationTick = nullptr;
+    bool            m_bTickScheduled = false;
 
     // Anim stuff
     void            animationPopin(CWindow*, bool close = false);
@@ -1,7 +1,12 @@
 #include "InputManager.hpp"
 #include "../Compositor.hpp"
 
+void CInputManager::onInput() {
+    clock_gettime(CLOCK_MONOTONIC, &m_tLastInputTime);
+}
+
 void CInputManager::onMouseMoved(wlr_pointer_motion_event* e) {
+    onInput();
 
     float sensitivity = g_pConfigManager->getFloat("general:sensitivity");
 
@@ -16,6 +21,8 @@ void CInputManager::onMouseMoved(wlr_pointer_motion_event* e) {
 }
 
 void CInputManager::onMouseWarp(wlr_pointer_motion_absolute_event* e) {
+    onInput();
+
     wlr_cursor_warp_absolute(g_pCompositor->m_sWLRCursor, &e->pointer->base, e->x, e->y);
 
     mouseMoveUnified(e->time_msec);
@@ -186,6 +193,8 @@ void CInputManager::mouseMoveUnified(uint32_t time, bool refocus) {
 }
 
 void CInputManager::onMouseButton(wlr_pointer_button_event* e) {
+    onInput();
+
     wlr_idle_notify_activity(g_pCompositor->m_sWLRIdle, g_pCompositor->m_sSeat.seat);
 
     const auto PKEYBOARD = wlr_seat_get_keyboard(g_pCompositor->m_sSeat.seat);
@@ -377,6 +386,8 @@ void CInputManager::destroyMouse(wlr_input_device* mouse) {
 }
 
 void CInputManager::onKeyboardKey(wlr_keyboard_key_event* e, SKeyboard* pKeyboard) {
+    onInput();
+
     const auto KEYCODE = e->keycode + 8; // Because to xkbcommon it's +8 from libinput
 
     const xkb_keysym_t* keysyms;
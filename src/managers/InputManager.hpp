@@ -42,9 +42,12 @@ public:
 
     SKeyboard*      m_pActiveKeyboard = nullptr;
 
+    timespec        m_tLastInputTime = {0, 0};  // CLOCK_MONOTONIC
+
    private:
 
     void            mouseMoveUnified(uint32_t, bool refocus = false);
+    void            onInput();
 };
 
 inline std::unique_ptr<CInputManager> g_pInputManager;
\ No newline at end of file
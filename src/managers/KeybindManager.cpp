@@ -368,6 +368,7 @@ void CKeybindManager::moveActiveToWorkspace(std::string args) {
 
     PWINDOW->m_iWorkspaceID = PWORKSPACE->m_iID;
     PWINDOW->m_iMonitorID = PWORKSPACE->m_iMonitorID;
+    g_pHyprRenderer->invalidateRenderList();
     PWINDOW->m_bIsFullscreen = false;
 
     if (PWORKSPACE->m_bHasFullscreenWindow) {
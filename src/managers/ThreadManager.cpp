@@ -1,7 +1,39 @@
 #include "ThreadManager.hpp"
 #include "../debug/HyprCtl.hpp"
 
+#include <fcntl.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+
+static int handleWakeup(int fd, uint32_t mask, void* data) {
+    char buf[64];
+    while (read(fd, buf, sizeof(buf)) > 0)
+        ;  // drain
+
+    HyprCtl::tickHyprCtl();
+
+    // a reload is done, its curves are the animation manager's business
+    g_pConfigManager->applyBeziers();
+
+    if (g_pConfigManager->m_bWantsMonitorReload)
+        g_pCompositor->scheduleHousekeeping();
+
+    // errors are drawn in a frame, make sure one comes
+    if (g_pHyprError->hasPending() && !g_pCompositor->m_lMonitors.empty())
+        g_pHyprRenderer->damageMonitor(&g_pCompositor->m_lMonitors.front());
+
+    return 0;
+}
+
 CThreadManager::CThreadManager() {
+    RASSERT(pipe(m_iWakeupFDs) == 0, "Couldn't create the wakeup pipe!");
+
+    fcntl(m_iWakeupFDs[0], F_SETFL, O_NONBLOCK);
+    fcntl(m_iWakeupFDs[1], F_SETFL, O_NONBLOCK);
+
+    m_pWakeupSource = wl_event_loop_add_fd(wl_display_get_event_loop(g_pCompositor->m_sWLDisplay), m_iWakeupFDs[0], WL_EVENT_READABLE, &handleWakeup, nullptr);
+
     m_tMainThread = new std::thread([&]() {
         // Call the handle method.
         this->handle();
@@ -14,7 +46,11 @@ CThreadManager::~CThreadManager() {
     //
 }
 
-int slowUpdate = 0;
+void CThreadManager::wakeMainThread() {
+    // if the pipe is full (EAGAIN) there's a wakeup pending already
+    if (write(m_iWakeupFDs[1], "w", 1) < 0 && errno != EAGAIN)
+        Debug::log(ERR, "Couldn't wake the main thread: %s", strerror(errno));
+}
 
 void CThreadManager::handle() {
 
@@ -22,13 +58,10 @@ void CThreadManager::handle() {
 
     HyprCtl::startHyprCtlSocket();
 
+    // the config only gets checked once a second, no need to wake up more often than that
     while (3.1415f) {
-        slowUpdate++;
-        if (slowUpdate >= g_pConfigManager->getInt("general:max_fps")){
-            g_pConfigManager->tick();
-            slowUpdate = 0;
-        }
+        std::this_thread::sleep_for(std::chrono::seconds(1));
 
-        std::this_thread::sleep_for(std::chrono::microseconds(1000000 / g_pConfigManager->getInt("general:max_fps")));
+        g_pConfigManager->tick();
     }
-}
\ No newline at end of file
+}
@@ -9,11 +9,17 @@ public:
     CThreadManager();
     ~CThreadManager();
 
+    // safe to call from any thread, runs the pending main thread work (IPC, reloads) on the event loop
+    void                wakeMainThread();
+
 private:
 
     void                handle();
 
     std::thread*        m_tMainThread;
+
+    int                 m_iWakeupFDs[2] = {-1, -1};
+    wl_event_source*    m_pWakeupSource = nullptr;
 };
 
-inline std::unique_ptr<CThreadManager> g_pThreadManager;
\ No newline at end of file
+inline std::unique_ptr<CThreadManager> g_pThreadManager;
@@ -0,0 +1,318 @@
+#include "ThumbnailManager.hpp"
+#include "../Compositor.hpp"
+#include "../../hyprland-workspace-thumbnail-unstable-v1-protocol.h"
+
+#define THUMBNAIL_VERSION 1
+
+// nobody asked for it in that long, drop it
+constexpr auto THUMBNAIL_IDLE_TIMEOUT = std::chrono::seconds(30);
+
+static void handleManagerBind(wl_client* client, void* data, uint32_t version, uint32_t id) {
+    g_pThumbnailManager->bindManager(client, version, id);
+}
+
+static void handleCaptureWorkspace(wl_client* client, wl_resource* resource, uint32_t frame, int32_t workspace) {
+    g_pThumbnailManager->captureWorkspace(client, resource, frame, workspace);
+}
+
+static void handleDestroy(wl_client* client, wl_resource* resource) {
+    wl_resource_destroy(resource);
+}
+
+static void handleCopy(wl_client* client, wl_resource* resource, wl_resource* buffer) {
+    g_pThumbnailManager->copyFrame((SThumbnailFrame*)wl_resource_get_user_data(resource), buffer);
+}
+
+static void handleFrameResourceDestroy(wl_resource* resource) {
+    g_pThumbnailManager->destroyFrame((SThumbnailFrame*)wl_resource_get_user_data(resource));
+}
+
+static void handleBufferDestroy(wl_listener* listener, void* data) {
+    g_pThumbnailManager->onBufferDestroyed(listener);
+}
+
+static const struct zhyprland_workspace_thumbnail_manager_v1_interface thumbnailManagerImpl = {
+    .capture_workspace = handleCaptureWorkspace,
+    .destroy = handleDestroy,
+};
+
+static const struct zhyprland_workspace_thumbnail_frame_v1_interface thumbnailFrameImpl = {
+    .copy = handleCopy,
+    .destroy = handleDestroy,
+};
+
+CThumbnailManager::CThumbnailManager() {
+    m_pGlobal = wl_global_create(g_pCompositor->m_sWLDisplay, &zhyprland_workspace_thumbnail_manager_v1_interface, THUMBNAIL_VERSION, this, handleManagerBind);
+
+    if (!m_pGlobal)
+        Debug::log(ERR, "Couldn't create the workspace thumbnail global!");
+}
+
+void CThumbnailManager::bindManager(wl_client* client, uint32_t version, uint32_t id) {
+    const auto RESOURCE = wl_resource_create(client, &zhyprland_workspace_thumbnail_manager_v1_interface, version, id);
+
+    if (!RESOURCE) {
+        wl_client_post_no_memory(client);
+        return;
+    }
+
+    wl_resource_set_implementation(RESOURCE, &thumbnailManagerImpl, this, nullptr);
+}
+
+Vector2D CThumbnailManager::thumbnailSizeFor(CWorkspace* pWorkspace) {
+    const auto PMONITOR = g_pCompositor->getMonitorFromID(pWorkspace->m_iMonitorID);
+
+    if (!PMONITOR)
+        return Vector2D();
+
+    const auto SCALE = std::clamp(g_pConfigManager->getFloat("general:thumbnail_scale"), 0.05f, 1.f);
+
+    return Vector2D(std::max(1.0, std::round(PMONITOR->vecPixelSize.x * SCALE)), std::max(1.0, std::round(PMONITOR->vecPixelSize.y * SCALE)));
+}
+
+void CThumbnailManager::captureWorkspace(wl_client* client, wl_resource* manager, uint32_t id, int workspaceID) {
+    const auto RESOURCE = wl_resource_create(client, &zhyprland_workspace_thumbnail_frame_v1_interface, wl_resource_get_version(manager), id);
+
+    if (!RESOURCE) {
+        wl_client_post_no_memory(client);
+        return;
+    }
+
+    const auto PFRAME = &m_lFrames.emplace_back();
+    PFRAME->resource = RESOURCE;
+    PFRAME->workspaceID = workspaceID;
+    PFRAME->bufferDestroy.notify = handleBufferDestroy;
+    wl_list_init(&PFRAME->bufferDestroy.link);
+
+    wl_resource_set_implementation(RESOURCE, &thumbnailFrameImpl, PFRAME, handleFrameResourceDestroy);
+
+    const auto PWORKSPACE = g_pCompositor->getWorkspaceByID(workspaceID);
+
+    if (!PWORKSPACE || !g_pCompositor->getMonitorFromID(PWORKSPACE->m_iMonitorID)) {
+        failFrame(PFRAME);
+        return;
+    }
+
+    // only makes the entry, it's rendered when the copy comes
+    const auto PTHUMBNAIL = &m_mThumbnails[workspaceID];
+    PTHUMBNAIL->pWorkspace = PWORKSPACE;
+    PTHUMBNAIL->lastRequested = std::chrono::steady_clock::now();
+
+    const auto SIZE = thumbnailSizeFor(PWORKSPACE);
+    zhyprland_workspace_thumbnail_frame_v1_send_buffer(RESOURCE, WL_SHM_FORMAT_XRGB8888, SIZE.x, SIZE.y, SIZE.x * 4);
+}
+
+void CThumbnailManager::copyFrame(SThumbnailFrame* pFrame, wl_resource* buffer) {
+    if (pFrame->used) {
+        wl_resource_post_error(pFrame->resource, ZHYPRLAND_WORKSPACE_THUMBNAIL_FRAME_V1_ERROR_ALREADY_USED, "frame already used");
+        return;
+    }
+
+    pFrame->used = true;
+
+    const auto SHMBUFFER = wl_shm_buffer_get(buffer);
+
+    if (!SHMBUFFER || wl_shm_buffer_get_format(SHMBUFFER) != WL_SHM_FORMAT_XRGB8888 || wl_shm_buffer_get_stride(SHMBUFFER) != wl_shm_buffer_get_width(SHMBUFFER) * 4) {
+        wl_resource_post_error(pFrame->resource, ZHYPRLAND_WORKSPACE_THUMBNAIL_FRAME_V1_ERROR_INVALID_BUFFER, "invalid buffer");
+        return;
+    }
+
+    const auto PWORKSPACE = g_pCompositor->getWorkspaceByID(pFrame->workspaceID);
+
+    // the monitor might've changed since the buffer event, not the client's fault
+    if (!PWORKSPACE || thumbnailSizeFor(PWORKSPACE) != Vector2D(wl_shm_buffer_get_width(SHMBUFFER), wl_shm_buffer_get_height(SHMBUFFER))) {
+        failFrame(pFrame);
+        return;
+    }
+
+    pFrame->buffer = buffer;
+    wl_resource_add_destroy_listener(buffer, &pFrame->bufferDestroy);
+
+    const auto PTHUMBNAIL = &m_mThumbnails[pFrame->workspaceID];
+    PTHUMBNAIL->pWorkspace = PWORKSPACE;
+    PTHUMBNAIL->lastRequested = std::chrono::steady_clock::now();
+
+    scheduleFrameFor(pFrame->workspaceID);
+}
+
+void CThumbnailManager::destroyFrame(SThumbnailFrame* pFrame) {
+    wl_list_remove(&pFrame->bufferDestroy.link);
+
+    m_lFrames.remove_if([&](const SThumbnailFrame& other) { return &other == pFrame; });
+}
+
+void CThumbnailManager::onBufferDestroyed(wl_listener* listener) {
+    for (auto& f : m_lFrames) {
+        if (&f.bufferDestroy == listener) {
+            failFrame(&f);
+            return;
+        }
+    }
+}
+
+void CThumbnailManager::failFrame(SThumbnailFrame* pFrame) {
+    wl_list_remove(&pFrame->bufferDestroy.link);
+    wl_list_init(&pFrame->bufferDestroy.link);
+    pFrame->buffer = nullptr;
+    pFrame->used = true;
+
+    zhyprland_workspace_thumbnail_frame_v1_send_failed(pFrame->resource);
+}
+
+void CThumbnailManager::scheduleFrameFor(int workspaceID) {
+    const auto PWORKSPACE = g_pCompositor->getWorkspaceByID(workspaceID);
+    const auto PMONITOR = PWORKSPACE ? g_pCompositor->getMonitorFromID(PWORKSPACE->m_iMonitorID) : nullptr;
+
+    if (PMONITOR)
+        wlr_output_schedule_frame(PMONITOR->output);
+}
+
+void CThumbnailManager::damageWorkspace(int id) {
+    const auto IT = m_mThumbnails.find(id);
+
+    if (IT != m_mThumbnails.end())
+        IT->second.dirty = true;
+}
+
+void CThumbnailManager::damageAll() {
+    for (auto& [id, thumbnail] : m_mThumbnails)
+        thumbnail.dirty = true;
+}
+
+void CThumbnailManager::onWorkspaceDestroyed(CWorkspace* pWorkspace) {
+    for (auto it = m_mThumbnails.begin(); it != m_mThumbnails.end(); ++it) {
+        if (it->second.pWorkspace != pWorkspace)
+            continue;
+
+        // we're not in a frame here, so no GL context to delete it with. The next update frees it
+        it->second.framebuffer.setOwner({GPU_OWNER_COMPOSITOR, nullptr, "thumbnail, pending release"});
+        m_vPendingRelease.push_back(it->second.framebuffer);
+        m_mThumbnails.erase(it);
+
+        const auto PMONITOR = g_pCompositor->getMonitorFromID(pWorkspace->m_iMonitorID);
+        if (PMONITOR)
+            wlr_output_schedule_frame(PMONITOR->output);
+        break;
+    }
+
+    for (auto& f : m_lFrames) {
+        if (f.buffer && f.workspaceID == pWorkspace->m_iID)
+            failFrame(&f);
+    }
+}
+
+bool CThumbnailManager::copyToBuffer(SThumbnail* pThumbnail, SThumbnailFrame* pFrame) {
+    const auto SHMBUFFER = wl_shm_buffer_get(pFrame->buffer);
+
+    if (pThumbnail->framebuffer.m_Size != Vector2D(wl_shm_buffer_get_width(SHMBUFFER), wl_shm_buffer_get_height(SHMBUFFER)))
+        return false;
+
+    wl_shm_buffer_begin_access(SHMBUFFER);
+    const bool COPIED = g_pHyprOpenGL->readFramebuffer(&pThumbnail->framebuffer, wl_shm_buffer_get_data(SHMBUFFER));
+    wl_shm_buffer_end_access(SHMBUFFER);
+
+    if (!COPIED)
+        return false;
+
+    // the time it was rendered, so that the client knows how old it is
+    const uint64_t SEC = pThumbnail->renderedAt.tv_sec;
+
+    wl_list_remove(&pFrame->bufferDestroy.link);
+    wl_list_init(&pFrame->bufferDestroy.link);
+    pFrame->buffer = nullptr;
+
+    zhyprland_workspace_thumbnail_frame_v1_send_ready(pFrame->resource, SEC >> 32, SEC & 0xFFFFFFFF, pThumbnail->renderedAt.tv_nsec);
+
+    m_iFramesCopied++;
+
+    return true;
+}
+
+void CThumbnailManager::updateForMonitor(SMonitor* pMonitor) {
+    const auto NOW = std::chrono::steady_clock::now();
+
+    std::vector<int> idle;
+    for (auto& [id, thumbnail] : m_mThumbnails) {
+        if (thumbnail.pWorkspace->m_iMonitorID == pMonitor->ID && NOW - thumbnail.lastRequested > THUMBNAIL_IDLE_TIMEOUT)
+            idle.push_back(id);
+    }
+
+    std::vector<SThumbnailFrame*> waiting;
+    for (auto& f : m_lFrames) {
+        if (!f.buffer)
+            continue;
+
+        const auto IT = m_mThumbnails.find(f.workspaceID);
+        if (IT != m_mThumbnails.end() && IT->second.pWorkspace->m_iMonitorID == pMonitor->ID)
+            waiting.push_back(&f);
+    }
+
+    if (waiting.empty() && idle.empty() && m_vPendingRelease.empty())
+        return;
+
+    const auto BUDGET = std::max(1, g_pConfigManager->getInt("general:thumbnail_budget"));
+    const auto MAXFPS = g_pConfigManager->getInt("general:thumbnail_max_fps");
+
+    const wlr_box MONITORBOX = {0, 0, pMonitor->vecPixelSize.x, pMonitor->vecPixelSize.y};
+
+    wlr_output_attach_render(pMonitor->output, nullptr);
+
+    pixman_region32_t fakeDamage;
+    pixman_region32_init_rect(&fakeDamage, 0, 0, MONITORBOX.width, MONITORBOX.height);
+
+    g_pHyprOpenGL->begin(pMonitor, &fakeDamage, true);
+
+    // the GL context is only current in here
+    for (auto& fb : m_vPendingRelease)
+        fb.release();
+    m_vPendingRelease.clear();
+
+    for (auto& id : idle) {
+        m_mThumbnails[id].framebuffer.release();
+        m_mThumbnails.erase(id);
+    }
+
+    int  rendered = 0;
+    bool postponed = false;
+
+    for (auto& PFRAME : waiting) {
+        const auto PTHUMBNAIL = &m_mThumbnails[PFRAME->workspaceID];
+        const auto SIZE = thumbnailSizeFor(PTHUMBNAIL->pWorkspace);
+        const bool HASOLD = PTHUMBNAIL->framebuffer.m_cTex.m_iTexID && PTHUMBNAIL->framebuffer.m_Size == SIZE;
+
+        if (PTHUMBNAIL->dirty || !HASOLD) {
+            const bool THROTTLED = MAXFPS > 0 && NOW - PTHUMBNAIL->rendered < std::chrono::milliseconds(1000 / MAXFPS);
+
+            if (rendered < BUDGET && (!THROTTLED || !HASOLD)) {
+                g_pHyprOpenGL->renderWorkspaceThumbnail(PTHUMBNAIL->pWorkspace, &PTHUMBNAIL->framebuffer, SIZE);
+
+                PTHUMBNAIL->dirty = false;
+                PTHUMBNAIL->rendered = NOW;
+                clock_gettime(CLOCK_MONOTONIC, &PTHUMBNAIL->renderedAt);
+                rendered++;
+                m_iThumbnailsRendered++;
+            } else if (!HASOLD) {
+                // nothing to give it yet, next frame
+                postponed = true;
+                continue;
+            }
+
+            // otherwise the old one will do, the timestamp says how old it is
+        }
+
+        if (!copyToBuffer(PTHUMBNAIL, PFRAME))
+            failFrame(PFRAME);
+    }
+
+    g_pHyprOpenGL->end();
+
+    wlr_output_rollback(pMonitor->output);
+
+    pixman_region32_fini(&fakeDamage);
+
+    if (rendered > 0)
+        g_pHyprOpenGL->invalidatePrimaryFB(pMonitor, MONITORBOX);
+
+    if (postponed)
+        wlr_output_schedule_frame(pMonitor->output);
+}
@@ -0,0 +1,71 @@
+#pragma once
+
+#include "../defines.hpp"
+#include <list>
+#include <unordered_map>
+#include <chrono>
+#include "../render/Framebuffer.hpp"
+
+struct SMonitor;
+class CWorkspace;
+
+// one zhyprland_workspace_thumbnail_frame_v1
+struct SThumbnailFrame {
+    wl_resource*    resource = nullptr;
+    int             workspaceID = -1;
+
+    wl_resource*    buffer = nullptr;  // from copy, until the thumbnail is up to date
+    wl_listener     bufferDestroy;
+
+    bool            used = false;      // copy was sent
+};
+
+struct SThumbnail {
+    CWorkspace*     pWorkspace = nullptr;
+    CFramebuffer    framebuffer;
+    bool            dirty = true;      // its windows changed since it was rendered
+    std::chrono::steady_clock::time_point rendered;  // for the throttling
+    timespec        renderedAt = {0, 0};  // CLOCK_MONOTONIC, for the ready event
+    std::chrono::steady_clock::time_point lastRequested;
+};
+
+// Downscaled previews of workspaces for overviews, visible or not.
+// They're only rendered when a client asks for one and its windows changed
+// since the last time, at most general:thumbnail_max_fps times a second each
+// and general:thumbnail_budget of them per monitor frame.
+class CThumbnailManager {
+public:
+    CThumbnailManager();
+
+    void            damageWorkspace(int id);
+    void            damageAll();
+    void            onWorkspaceDestroyed(CWorkspace*);
+
+    // renders what's due and fills the waiting buffers, call before rendering the monitor
+    void            updateForMonitor(SMonitor*);
+
+    Vector2D        thumbnailSizeFor(CWorkspace*);
+
+    // for the protocol
+    void            bindManager(wl_client*, uint32_t version, uint32_t id);
+    void            captureWorkspace(wl_client*, wl_resource* manager, uint32_t id, int workspaceID);
+    void            copyFrame(SThumbnailFrame*, wl_resource* buffer);
+    void            destroyFrame(SThumbnailFrame*);
+    void            onBufferDestroyed(wl_listener*);
+
+    int             m_iThumbnailsRendered = 0;
+    int             m_iFramesCopied = 0;
+
+private:
+    wl_global*      m_pGlobal = nullptr;
+
+    std::unordered_map<int, SThumbnail> m_mThumbnails;  // workspace ID ->
+    std::list<SThumbnailFrame> m_lFrames;
+    std::vector<CFramebuffer> m_vPendingRelease;  // of destroyed workspaces, freed in the next update
+
+    bool            copyToBuffer(SThumbnail*, SThumbnailFrame*);
+    void            failFrame(SThumbnailFrame*);
+    void            scheduleFrameFor(int workspaceID);
+};
+
+inline std::unique_ptr<CThumbnailManager> g_pThumbnailManager;
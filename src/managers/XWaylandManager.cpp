@@ -118,18 +118,89 @@ void CHyprXWaylandManager::sendCloseWindow(CWindow* pWindow) {
     }
 }
 
-void CHyprXWaylandManager::setWindowSize(CWindow* pWindow, const Vector2D& size) {
-    if (pWindow->m_bIsX11)
-        wlr_xwayland_surface_configure(pWindow->m_uSurface.xwayland, pWindow->m_vRealPosition.vec().x, pWindow->m_vRealPosition.vec().y, size.x, size.y);
-    else {
+void CHyprXWaylandManager::setWindowSize(CWindow* pWindow, const Vector2D& size, bool force) {
+    // animations and drags call this on every tick / motion event, so by default
+    // it only gets queued and the window's monitor sends it once before rendering.
+    // force is for replies to the client, which shouldn't wait.
+    const auto PMONITOR = g_pCompositor->getMonitorFromID(pWindow->m_iMonitorID);
+
+    if (force || !PMONITOR || !PMONITOR->output->enabled) {
+        pWindow->m_bConfigureQueued = false;
+        sendWindowSize(pWindow, size);
+        return;
+    }
+
+    if (pWindow->m_bConfigureQueued)
+        m_iConfiguresCoalesced++;
+    else if (size == pWindow->m_vConfigureSentSize && (!pWindow->m_bIsX11 || pWindow->m_vConfigureSentPos == pWindow->m_vRealPosition.vec())) {
+        // nothing new, don't bother with a frame either
+        m_iConfiguresSkipped++;
+        return;
+    }
+
+    pWindow->m_vConfigureQueuedSize = size;
+    pWindow->m_bConfigureQueued = true;
+
+    wlr_output_schedule_frame(PMONITOR->output);
+}
+
+void CHyprXWaylandManager::flushWindowConfigures(SMonitor* pMonitor) {
+    const bool WAITFORACK = g_pConfigManager->getInt("general:configure_wait_ack");
+
+    for (auto& w : g_pCompositor->m_lWindows) {
+        if (!w.m_bConfigureQueued)
+            continue;
+
+        if (!g_pCompositor->windowValidMapped(&w)) {
+            w.m_bConfigureQueued = false;
+            continue;
+        }
+
+        // nullptr flushes whatever isn't on an enabled monitor
+        const auto PWINDOWMONITOR = g_pCompositor->getMonitorFromID(w.m_iMonitorID);
+        if (pMonitor ? PWINDOWMONITOR != pMonitor : PWINDOWMONITOR && PWINDOWMONITOR->output->enabled)
+            continue;
+
+        // stays queued, the commit with the ack will schedule a frame
+        if (WAITFORACK && !lastConfigureAcked(&w))
+            continue;
+
+        w.m_bConfigureQueued = false;
+
+        const bool SAMEPOS = !w.m_bIsX11 || w.m_vConfigureSentPos == w.m_vRealPosition.vec();
+        if (SAMEPOS && w.m_vConfigureQueuedSize == w.m_vConfigureSentSize) {
+            m_iConfiguresSkipped++;
+            continue;
+        }
+
+        sendWindowSize(&w, w.m_vConfigureQueuedSize);
+    }
+}
+
+void CHyprXWaylandManager::sendWindowSize(CWindow* pWindow, const Vector2D& size) {
+    if (pWindow->m_bIsX11) {
+        configureXWaylandWindow(pWindow, pWindow->m_vRealPosition.vec(), size);
+    } else {
+        m_iConfiguresSent++;
+        pWindow->m_vConfigureSentSize = size;
+
         // I don't know if this is fucking correct, but the fucking idea of putting shadows into a window's surface is borderline criminal.
         const auto XDELTA = pWindow->m_uSurface.xdg->surface->current.width - pWindow->m_uSurface.xdg->current.geometry.width;
         const auto YDELTA = pWindow->m_uSurface.xdg->surface->current.height - pWindow->m_uSurface.xdg->current.geometry.height;
         
-        wlr_xdg_toplevel_set_size(pWindow->m_uSurface.xdg->toplevel, size.x - XDELTA, size.y - YDELTA);
+        pWindow->m_iConfigureSerial = wlr_xdg_toplevel_set_size(pWindow->m_uSurface.xdg->toplevel, size.x - XDELTA, size.y - YDELTA);
     }
 }
 
+bool CHyprXWaylandManager::lastConfigureAcked(CWindow* pWindow) {
+    // X11 has no acks
+    if (pWindow->m_bIsX11 || pWindow->m_iConfigureSerial == 0)
+        return true;
+
+    // serials wrap
+    return (int32_t)(pWindow->m_uSurface.xdg->current.configure_serial - pWindow->m_iConfigureSerial) >= 0;
+}
+
 void CHyprXWaylandManager::setWindowStyleTiled(CWindow* pWindow, uint32_t edgez) {
     if (!pWindow->m_bIsX11)
         wlr_xdg_toplevel_set_tiled(pWindow->m_uSurface.xdg->toplevel, edgez);
@@ -191,10 +262,19 @@ void CHyprXWaylandManager::moveXWaylandWindow(CWindow* pWindow, const Vector2D&
         return;
         
     if (pWindow->m_bIsX11) {
-        wlr_xwayland_surface_configure(pWindow->m_uSurface.xwayland, pos.x, pos.y, pWindow->m_vRealSize.vec().x, pWindow->m_vRealSize.vec().y);
+        configureXWaylandWindow(pWindow, pos, pWindow->m_vRealSize.vec());
     }
 }
 
+void CHyprXWaylandManager::configureXWaylandWindow(CWindow* pWindow, const Vector2D& pos, const Vector2D& size) {
+    // every X11 configure goes through here, so that the coalescing knows what the client was told last
+    m_iConfiguresSent++;
+    pWindow->m_vConfigureSentPos = pos;
+    pWindow->m_vConfigureSentSize = size;
+
+    wlr_xwayland_surface_configure(pWindow->m_uSurface.xwayland, pos.x, pos.y, size.x, size.y);
+}
+
 void CHyprXWaylandManager::checkBorders(CWindow* pWindow) {
     if (!pWindow->m_bIsX11)
         return;
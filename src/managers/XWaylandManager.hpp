@@ -17,13 +17,23 @@ public:
     std::string         getTitle(CWindow*);
     std::string         getAppIDClass(CWindow*);
     void                sendCloseWindow(CWindow*);
-    void                setWindowSize(CWindow*, const Vector2D&);
+    void                setWindowSize(CWindow*, const Vector2D&, bool force = false);
+    void                flushWindowConfigures(SMonitor*);
     void                setWindowStyleTiled(CWindow*, uint32_t);
     void                setWindowFullscreen(CWindow*, bool);
     wlr_surface*        surfaceAt(CWindow*, const Vector2D&, Vector2D&);
     bool                shouldBeFloated(CWindow*);
     void                moveXWaylandWindow(CWindow*, const Vector2D&);
+    void                configureXWaylandWindow(CWindow*, const Vector2D& pos, const Vector2D& size);
     void                checkBorders(CWindow*);
+
+    int                 m_iConfiguresSent = 0;
+    int                 m_iConfiguresSkipped = 0;    // same size as the last one
+    int                 m_iConfiguresCoalesced = 0;  // replaced by a newer one before the frame
+
+private:
+    void                sendWindowSize(CWindow*, const Vector2D&);
+    bool                lastConfigureAcked(CWindow*);
 };
 
 inline std::unique_ptr<CHyprXWaylandManager> g_pXWaylandManager;
\ No newline at end of file
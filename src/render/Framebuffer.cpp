@@ -7,37 +7,41 @@ bool CFramebuffer::alloc(int w, int h) {
     {
         firstAlloc = true;
         glGenFramebuffers(1, &m_iFb);
+        g_pHyprOpenGL->m_sGPUResources.add(GPU_RESOURCE_FRAMEBUFFER, m_iFb, m_sOwner);
     }
 
     if (m_cTex.m_iTexID == 0)
     {
         firstAlloc = true;
         glGenTextures(1, &m_cTex.m_iTexID);
-        glBindTexture(GL_TEXTURE_2D, m_cTex.m_iTexID);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+        g_pHyprOpenGL->m_sGPUResources.add(GPU_RESOURCE_TEXTURE, m_cTex.m_iTexID, m_sOwner);
+        g_pHyprOpenGL->m_sGLState.bindTexture(GL_TEXTURE_2D, m_cTex.m_iTexID);
+        g_pHyprOpenGL->m_sGLState.texParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        g_pHyprOpenGL->m_sGLState.texParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        g_pHyprOpenGL->m_sGLState.texParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        g_pHyprOpenGL->m_sGLState.texParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
     }
 
     if (firstAlloc || m_Size != Vector2D(w, h))
     {
-        glBindTexture(GL_TEXTURE_2D, m_cTex.m_iTexID);
+        g_pHyprOpenGL->m_sGLState.bindTexture(GL_TEXTURE_2D, m_cTex.m_iTexID);
         glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, w, h, 0, GL_RGBA, GL_UNSIGNED_BYTE, 0);
+        g_pHyprOpenGL->m_sGPUResources.setStorage(m_cTex.m_iTexID, Vector2D(w, h), "RGBA8", 4);
 
         glBindFramebuffer(GL_FRAMEBUFFER, m_iFb);
-        glBindTexture(GL_TEXTURE_2D, m_cTex.m_iTexID);
+        g_pHyprOpenGL->m_sGLState.bindTexture(GL_TEXTURE_2D, m_cTex.m_iTexID);
         glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, m_cTex.m_iTexID, 0);
 
 
         // TODO: Allow this with gles2
         #ifndef GLES2
         if (m_pStencilTex) {
-            glBindTexture(GL_TEXTURE_2D, m_pStencilTex->m_iTexID);
+            g_pHyprOpenGL->m_sGLState.bindTexture(GL_TEXTURE_2D, m_pStencilTex->m_iTexID);
             glTexImage2D(GL_TEXTURE_2D, 0, GL_DEPTH24_STENCIL8, w, h, 0, GL_DEPTH_STENCIL, GL_UNSIGNED_INT_24_8, 0);
+            g_pHyprOpenGL->m_sGPUResources.setStorage(m_pStencilTex->m_iTexID, Vector2D(w, h), "D24S8", 4);
 
             glBindFramebuffer(GL_FRAMEBUFFER, m_iFb);
-            glBindTexture(GL_TEXTURE_2D, m_pStencilTex->m_iTexID);
+            g_pHyprOpenGL->m_sGLState.bindTexture(GL_TEXTURE_2D, m_pStencilTex->m_iTexID);
 
             glFramebufferTexture2D(GL_FRAMEBUFFER, GL_STENCIL_ATTACHMENT, GL_TEXTURE_2D, m_pStencilTex->m_iTexID, 0);
         }
@@ -49,7 +53,7 @@ bool CFramebuffer::alloc(int w, int h) {
         Debug::log(LOG, "Framebuffer created, status %i", status);
     }
 
-    glBindTexture(GL_TEXTURE_2D, 0);
+    g_pHyprOpenGL->m_sGLState.bindTexture(GL_TEXTURE_2D, 0);
     glBindFramebuffer(GL_FRAMEBUFFER, g_pHyprOpenGL->m_iCurrentOutputFb);
 
     m_Size = Vector2D(w, h);
@@ -58,6 +62,9 @@ bool CFramebuffer::alloc(int w, int h) {
 }
 
 void CFramebuffer::bind() {
+    // pending rects belong to the previous target
+    g_pHyprOpenGL->flushRectBatch();
+
     #ifndef GLES2
     glBindFramebuffer(GL_DRAW_FRAMEBUFFER, m_iFb);
     #else
@@ -69,12 +76,25 @@ void CFramebuffer::bind() {
 void CFramebuffer::release() {
     if (m_iFb != (uint32_t)-1 && m_iFb) {
         glDeleteFramebuffers(1, &m_iFb);
+        g_pHyprOpenGL->m_sGPUResources.remove(GPU_RESOURCE_FRAMEBUFFER, m_iFb);
     }
 
     if (m_cTex.m_iTexID) {
         glDeleteTextures(1, &m_cTex.m_iTexID);
+        g_pHyprOpenGL->m_sGLState.onTextureDeleted(m_cTex.m_iTexID);
+        g_pHyprOpenGL->m_sGPUResources.remove(GPU_RESOURCE_TEXTURE, m_cTex.m_iTexID);
     }
 
     m_cTex.m_iTexID = 0;
     m_iFb = -1;
 }
+
+void CFramebuffer::setOwner(const SGPUOwner& owner) {
+    m_sOwner = owner;
+
+    if (m_iFb != (uint32_t)-1)
+        g_pHyprOpenGL->m_sGPUResources.setOwner(GPU_RESOURCE_FRAMEBUFFER, m_iFb, owner);
+
+    if (m_cTex.m_iTexID)
+        g_pHyprOpenGL->m_sGPUResources.setOwner(GPU_RESOURCE_TEXTURE, m_cTex.m_iTexID, owner);
+}
@@ -10,6 +10,7 @@ public:
     void bind();
     void release();
     void reset();
+    void setOwner(const SGPUOwner&);
 
     Vector2D        m_Position;
     Vector2D        m_Size;
@@ -20,5 +21,7 @@ public:
 
     CTexture*       m_pStencilTex = nullptr;
 
+    SGPUOwner       m_sOwner;  // for the GPU resource registry, set before alloc()
+
     wl_output_transform m_tTransform; // for saving state
 };
\ No newline at end of file
@@ -0,0 +1,86 @@
+#include "FramebufferPool.hpp"
+
+constexpr int    POOL_BUCKET_SIZE = 128;
+constexpr int    POOL_MAX_IDLE = 4;
+
+static int roundToBucket(int size) {
+    return std::max(1, (size + POOL_BUCKET_SIZE - 1) / POOL_BUCKET_SIZE) * POOL_BUCKET_SIZE;
+}
+
+CFramebuffer* CFramebufferPool::get(int w, int h) {
+    const int BUCKETW = roundToBucket(w);
+    const int BUCKETH = roundToBucket(h);
+    const size_t BYTES = (size_t)BUCKETW * BUCKETH * 4;
+
+    // take the smallest idle one that fits, as long as it's not way too big
+    SPooledFramebuffer* pBest = nullptr;
+    for (auto& pfb : m_lFramebuffers) {
+        if (pfb.inUse || pfb.fb.m_Size.x < BUCKETW || pfb.fb.m_Size.y < BUCKETH || pfb.bytes > BYTES * 2)
+            continue;
+
+        if (!pBest || pfb.bytes < pBest->bytes)
+            pBest = &pfb;
+    }
+
+    if (pBest) {
+        m_iHits++;
+    } else {
+        m_iMisses++;
+
+        pBest = &m_lFramebuffers.emplace_back();
+        pBest->fb.m_sOwner = {GPU_OWNER_COMPOSITOR, nullptr, "snapshot pool"};
+        pBest->fb.alloc(BUCKETW, BUCKETH);
+        pBest->bytes = BYTES;
+        m_iBytesAllocated += BYTES;
+    }
+
+    pBest->inUse = true;
+    m_iBytesInUse += pBest->bytes;
+
+    return &pBest->fb;
+}
+
+void CFramebufferPool::put(CFramebuffer* pFramebuffer) {
+    for (auto it = m_lFramebuffers.begin(); it != m_lFramebuffers.end(); ++it) {
+        if (&it->fb != pFramebuffer)
+            continue;
+
+        if (!it->inUse)
+            return;
+
+        it->inUse = false;
+        m_iBytesInUse -= it->bytes;
+        it->fb.setOwner({GPU_OWNER_COMPOSITOR, nullptr, "snapshot pool"});
+
+        // keep the most recently returned at the back, trim() drops from the front
+        m_lFramebuffers.splice(m_lFramebuffers.end(), m_lFramebuffers, it);
+        break;
+    }
+
+    trim();
+}
+
+void CFramebufferPool::trim() {
+    int idle = std::count_if(m_lFramebuffers.begin(), m_lFramebuffers.end(), [](const SPooledFramebuffer& pfb) { return !pfb.inUse; });
+
+    for (auto it = m_lFramebuffers.begin(); it != m_lFramebuffers.end() && idle > POOL_MAX_IDLE;) {
+        if (it->inUse) {
+            ++it;
+            continue;
+        }
+
+        it->fb.release();
+        m_iBytesAllocated -= it->bytes;
+        it = m_lFramebuffers.erase(it);
+        idle--;
+    }
+}
+
+void CFramebufferPool::clear() {
+    for (auto& pfb : m_lFramebuffers)
+        pfb.fb.release();
+
+    m_lFramebuffers.clear();
+    m_iBytesAllocated = 0;
+    m_iBytesInUse = 0;
+}
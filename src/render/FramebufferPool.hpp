@@ -0,0 +1,32 @@
+#pragma once
+
+#include "../defines.hpp"
+#include "Framebuffer.hpp"
+#include <list>
+
+// Hands out framebuffers with their size rounded up to a bucket,
+// so that short-lived ones (e.g. close snapshots) get reused
+// instead of being reallocated every time.
+class CFramebufferPool {
+public:
+    CFramebuffer*   get(int w, int h);
+    void            put(CFramebuffer*);
+    void            clear();
+
+    size_t          m_iBytesAllocated = 0;
+    size_t          m_iBytesInUse = 0;
+    int             m_iHits = 0;
+    int             m_iMisses = 0;
+
+private:
+    struct SPooledFramebuffer {
+        CFramebuffer    fb;
+        bool            inUse = false;
+        size_t          bytes = 0;
+    };
+
+    void            trim();
+
+    // list so that the pointers we hand out stay valid
+    std::list<SPooledFramebuffer> m_lFramebuffers;
+};
@@ -0,0 +1,181 @@
+#include "GLState.hpp"
+
+bool CGLState::shouldIssue(bool changed) {
+    if (changed)
+        m_iCallsIssued++;
+    else
+        m_iCallsElided++;
+
+    return changed;
+}
+
+void CGLState::invalidate() {
+    m_iProgram = -1;
+    m_iActiveTexture = -1;
+    m_mBoundTextures.clear();
+    m_mTexMinFilters.clear();
+    m_mCapabilities.clear();
+    m_iBlendSrc = -1;
+    m_iBlendDst = -1;
+    m_bAttribsKnown = false;
+    m_iVertexArray = -1;
+    m_iArrayBuffer = -1;
+}
+
+void CGLState::resetCounters() {
+    m_iCallsIssued = 0;
+    m_iCallsElided = 0;
+    m_iDrawCalls = 0;
+}
+
+void CGLState::useProgram(GLuint program) {
+    if (!shouldIssue(m_iProgram != (GLint)program))
+        return;
+
+    glUseProgram(program);
+    m_iProgram = program;
+}
+
+void CGLState::activeTexture(GLenum unit) {
+    if (!shouldIssue(m_iActiveTexture != (GLint)unit))
+        return;
+
+    glActiveTexture(unit);
+    m_iActiveTexture = unit;
+}
+
+void CGLState::bindTexture(GLenum target, GLuint tex) {
+    const auto IT = m_mBoundTextures.find(target);
+
+    // we only ever use unit 0, so if it's unknown we can't trust the binding either
+    if (!shouldIssue(m_iActiveTexture == -1 || IT == m_mBoundTextures.end() || IT->second != (GLint)tex))
+        return;
+
+    glBindTexture(target, tex);
+    m_mBoundTextures[target] = tex;
+}
+
+void CGLState::texParameteri(GLenum target, GLenum pname, GLint param) {
+    // only the min filter is set on every draw, the rest goes straight through
+    if (pname != GL_TEXTURE_MIN_FILTER) {
+        m_iCallsIssued++;
+        glTexParameteri(target, pname, param);
+        return;
+    }
+
+    const auto BOUND = m_mBoundTextures.find(target);
+
+    if (BOUND == m_mBoundTextures.end()) {
+        m_iCallsIssued++;
+        glTexParameteri(target, pname, param);
+        return;
+    }
+
+    const auto IT = m_mTexMinFilters.find(BOUND->second);
+
+    if (!shouldIssue(IT == m_mTexMinFilters.end() || IT->second != param))
+        return;
+
+    glTexParameteri(target, pname, param);
+    m_mTexMinFilters[BOUND->second] = param;
+}
+
+void CGLState::setCapability(GLenum cap, bool enabled) {
+    const auto IT = m_mCapabilities.find(cap);
+
+    if (!shouldIssue(IT == m_mCapabilities.end() || IT->second != (int)enabled))
+        return;
+
+    if (enabled)
+        glEnable(cap);
+    else
+        glDisable(cap);
+
+    m_mCapabilities[cap] = enabled;
+}
+
+void CGLState::blendFunc(GLenum sfactor, GLenum dfactor) {
+    if (!shouldIssue(m_iBlendSrc != (GLint)sfactor || m_iBlendDst != (GLint)dfactor))
+        return;
+
+    glBlendFunc(sfactor, dfactor);
+    m_iBlendSrc = sfactor;
+    m_iBlendDst = dfactor;
+}
+
+void CGLState::setVertexAttribArrays(GLint a, GLint b) {
+    uint32_t wanted = 0;
+    if (a >= 0)
+        wanted |= 1u << a;
+    if (b >= 0)
+        wanted |= 1u << b;
+
+    if (!m_bAttribsKnown) {
+        // wlr disables its arrays after drawing, so assume nothing is on
+        m_iEnabledAttribs = 0;
+        m_bAttribsKnown = true;
+    }
+
+    for (int i = 0; i < 32; ++i) {
+        const bool WANTED = wanted & (1u << i);
+        const bool ENABLED = m_iEnabledAttribs & (1u << i);
+
+        if (WANTED == ENABLED) {
+            if (WANTED)
+                m_iCallsElided++;
+            continue;
+        }
+
+        m_iCallsIssued++;
+
+        if (WANTED)
+            glEnableVertexAttribArray(i);
+        else
+            glDisableVertexAttribArray(i);
+    }
+
+    m_iEnabledAttribs = wanted;
+}
+
+void CGLState::disableAllVertexAttribArrays() {
+    setVertexAttribArrays(-1, -1);
+}
+
+void CGLState::bindVertexArray(GLuint vao) {
+#ifndef GLES2
+    if (!shouldIssue(m_iVertexArray != (GLint)vao))
+        return;
+
+    glBindVertexArray(vao);
+    m_iVertexArray = vao;
+#endif
+}
+
+void CGLState::bindArrayBuffer(GLuint buffer) {
+    if (!shouldIssue(m_iArrayBuffer != (GLint)buffer))
+        return;
+
+    glBindBuffer(GL_ARRAY_BUFFER, buffer);
+    m_iArrayBuffer = buffer;
+}
+
+void CGLState::drawArrays(GLenum mode, GLint first, GLsizei count) {
+    m_iDrawCalls++;
+    glDrawArrays(mode, first, count);
+}
+
+bool CGLState::isKnownDisabled(GLenum cap) {
+    const auto IT = m_mCapabilities.find(cap);
+
+    return IT != m_mCapabilities.end() && IT->second == 0;
+}
+
+void CGLState::onTextureDeleted(GLuint tex) {
+    // GL unbinds deleted textures, and the name can be reused
+    for (auto& [target, bound] : m_mBoundTextures) {
+        if (bound == (GLint)tex)
+            bound = 0;
+    }
+
+    m_mTexMinFilters.erase(tex);
+}
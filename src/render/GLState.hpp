@@ -0,0 +1,50 @@
+#pragma once
+
+#include "../defines.hpp"
+#include <unordered_map>
+
+// Shadow copy of the GL state we touch, so that we don't issue
+// calls that wouldn't change anything.
+// wlroots shares our context, so this has to be invalidated whenever
+// it might've rendered something (see begin() and end())
+class CGLState {
+public:
+    void    invalidate();
+
+    void    useProgram(GLuint);
+    void    activeTexture(GLenum);
+    void    bindTexture(GLenum target, GLuint);
+    void    texParameteri(GLenum target, GLenum pname, GLint param);
+    void    setCapability(GLenum cap, bool enabled);
+    void    blendFunc(GLenum sfactor, GLenum dfactor);
+    void    setVertexAttribArrays(GLint, GLint);  // enables these two, disables the rest
+    void    disableAllVertexAttribArrays();
+    void    bindVertexArray(GLuint);
+    void    bindArrayBuffer(GLuint);
+    void    drawArrays(GLenum mode, GLint first, GLsizei count);
+
+    bool    isKnownDisabled(GLenum cap);
+
+    void    onTextureDeleted(GLuint);
+
+    void    resetCounters();
+
+    int     m_iCallsIssued = 0;
+    int     m_iCallsElided = 0;
+    int     m_iDrawCalls = 0;
+
+private:
+    bool    shouldIssue(bool changed);
+
+    GLint   m_iProgram = -1;
+    GLint   m_iActiveTexture = -1;
+    std::unordered_map<GLenum, GLint> m_mBoundTextures;
+    std::unordered_map<GLuint, GLint> m_mTexMinFilters;  // only for textures bound this frame
+    std::unordered_map<GLenum, int>   m_mCapabilities;   // -1 unknown, 0 off, 1 on
+    GLint   m_iBlendSrc = -1;
+    GLint   m_iBlendDst = -1;
+    uint32_t m_iEnabledAttribs = 0;
+    bool    m_bAttribsKnown = false;
+    GLint   m_iVertexArray = -1;
+    GLint   m_iArrayBuffer = -1;
+};
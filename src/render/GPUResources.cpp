@@ -0,0 +1,147 @@
+#include "GPUResources.hpp"
+#include "../Compositor.hpp"
+#include "../helpers/MiscFunctions.hpp"
+
+void CGPUResourceRegistry::add(eGPUResourceType type, GLuint id, const SGPUOwner& owner) {
+    if (!id)
+        return;
+
+    const auto PRESOURCE = &m_mResources[key(type, id)];
+
+    // GL reuses names, so whatever was here is long gone
+    m_iBytes -= PRESOURCE->bytes;
+
+    *PRESOURCE = SGPUResource();
+    PRESOURCE->type = type;
+    PRESOURCE->id = id;
+    PRESOURCE->owner = owner;
+    PRESOURCE->created = std::chrono::steady_clock::now();
+}
+
+void CGPUResourceRegistry::remove(eGPUResourceType type, GLuint id) {
+    const auto IT = m_mResources.find(key(type, id));
+
+    if (IT == m_mResources.end())
+        return;
+
+    m_iBytes -= IT->second.bytes;
+    m_mResources.erase(IT);
+}
+
+void CGPUResourceRegistry::setOwner(eGPUResourceType type, GLuint id, const SGPUOwner& owner) {
+    const auto IT = m_mResources.find(key(type, id));
+
+    if (IT == m_mResources.end())
+        return;
+
+    IT->second.owner = owner;
+    IT->second.warned = false;
+}
+
+void CGPUResourceRegistry::setStorage(GLuint tex, const Vector2D& size, const std::string& format, int bytesPerPixel) {
+    const auto IT = m_mResources.find(key(GPU_RESOURCE_TEXTURE, tex));
+
+    if (IT == m_mResources.end())
+        return;
+
+    m_iBytes -= IT->second.bytes;
+
+    IT->second.size = size;
+    IT->second.format = format;
+    IT->second.bytes = (size_t)size.x * (size_t)size.y * bytesPerPixel;
+
+    m_iBytes += IT->second.bytes;
+}
+
+bool CGPUResourceRegistry::ownerAlive(const SGPUOwner& owner) {
+    switch (owner.type) {
+        case GPU_OWNER_COMPOSITOR:
+            return true;
+        case GPU_OWNER_MONITOR:
+            for (auto& m : g_pCompositor->m_lMonitors) {
+                if (&m == owner.pOwner)
+                    return true;
+            }
+            return false;
+        case GPU_OWNER_WINDOW:
+            return g_pCompositor->windowExists((CWindow*)owner.pOwner);
+        case GPU_OWNER_LAYER:
+            for (auto& m : g_pCompositor->m_lMonitors) {
+                for (auto& lsl : m.m_aLayerSurfaceLists) {
+                    for (auto& ls : lsl) {
+                        if (ls == owner.pOwner)
+                            return true;
+                    }
+                }
+            }
+            // fading out ones aren't in the lists anymore
+            for (auto& ls : g_pCompositor->m_lSurfacesFadingOut) {
+                if (ls == owner.pOwner)
+                    return true;
+            }
+            return false;
+        case GPU_OWNER_WORKSPACE:
+            for (auto& ws : g_pCompositor->m_lWorkspaces) {
+                if (&ws == owner.pOwner)
+                    return true;
+            }
+            return false;
+    }
+
+    return false;
+}
+
+std::string CGPUResourceRegistry::ownerName(const SGPUOwner& owner) {
+    std::string name = "";
+
+    switch (owner.type) {
+        case GPU_OWNER_COMPOSITOR: name = "compositor"; break;
+        case GPU_OWNER_MONITOR: name = "monitor " + (ownerAlive(owner) ? ((SMonitor*)owner.pOwner)->szName : getFormat("%x (gone)", owner.pOwner)); break;
+        case GPU_OWNER_WINDOW: name = "window " + (ownerAlive(owner) ? ((CWindow*)owner.pOwner)->m_szTitle : getFormat("%x (gone)", owner.pOwner)); break;
+        case GPU_OWNER_LAYER: name = getFormat("layer %x%s", owner.pOwner, ownerAlive(owner) ? "" : " (gone)"); break;
+        case GPU_OWNER_WORKSPACE: name = "workspace " + (ownerAlive(owner) ? ((CWorkspace*)owner.pOwner)->m_szName : getFormat("%x (gone)", owner.pOwner)); break;
+    }
+
+    return owner.what.empty() ? name : name + ", " + owner.what;
+}
+
+void CGPUResourceRegistry::checkOwners() {
+    for (auto& [k, res] : m_mResources) {
+        if (res.warned || ownerAlive(res.owner))
+            continue;
+
+        res.warned = true;
+
+        Debug::log(WARN, "GPU resource leak? %s %u (%s, %i KiB) outlived its owner: %s", res.type == GPU_RESOURCE_TEXTURE ? "texture" : "framebuffer", res.id, res.format.c_str(), (int)(res.bytes / 1024), ownerName(res.owner).c_str());
+    }
+}
+
+std::string CGPUResourceRegistry::getReport() {
+    const auto NOW = std::chrono::steady_clock::now();
+
+    std::string result = "";
+    int textures = 0, framebuffers = 0, leaked = 0;
+
+    for (auto& [k, res] : m_mResources) {
+        const bool ALIVE = ownerAlive(res.owner);
+        const auto AGE = std::chrono::duration_cast<std::chrono::seconds>(NOW - res.created).count();
+
+        if (res.type == GPU_RESOURCE_TEXTURE) {
+            textures++;
+            result += getFormat("texture %u: %ix%i %s, %i KiB, owner: %s, age: %is%s\n", res.id, (int)res.size.x, (int)res.size.y, res.format.empty() ? "(no storage)" : res.format.c_str(), (int)(res.bytes / 1024), ownerName(res.owner).c_str(), (int)AGE, ALIVE ? "" : " LEAKED?");
+        } else {
+            framebuffers++;
+            result += getFormat("framebuffer %u: owner: %s, age: %is%s\n", res.id, ownerName(res.owner).c_str(), (int)AGE, ALIVE ? "" : " LEAKED?");
+        }
+
+        if (!ALIVE)
+            leaked++;
+    }
+
+    result += getFormat("\ntotal: %i KiB in %i textures, %i framebuffers", (int)(m_iBytes / 1024), textures, framebuffers);
+    if (leaked)
+        result += getFormat(", %i without an owner", leaked);
+    result += "\n";
+
+    return result;
+}
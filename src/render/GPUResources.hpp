@@ -0,0 +1,67 @@
+#pragma once
+
+#include "../defines.hpp"
+#include <chrono>
+#include <unordered_map>
+
+struct SMonitor;
+class CWindow;
+struct SLayerSurface;
+class CWorkspace;
+
+enum eGPUResourceType {
+    GPU_RESOURCE_TEXTURE = 0,
+    GPU_RESOURCE_FRAMEBUFFER
+};
+
+enum eGPUOwnerType {
+    GPU_OWNER_COMPOSITOR = 0,   // lives as long as we do
+    GPU_OWNER_MONITOR,
+    GPU_OWNER_WINDOW,
+    GPU_OWNER_LAYER,
+    GPU_OWNER_WORKSPACE
+};
+
+struct SGPUOwner {
+    eGPUOwnerType   type = GPU_OWNER_COMPOSITOR;
+    void*           pOwner = nullptr;
+    std::string     what = "";  // e.g. "primary", "snapshot"
+};
+
+// Keeps track of every texture and FBO we create ourselves (not the ones wlr gives us),
+// so that hyprctl gpumem can show where the VRAM went and we can complain about leaks.
+class CGPUResourceRegistry {
+public:
+    void            add(eGPUResourceType, GLuint, const SGPUOwner&);
+    void            remove(eGPUResourceType, GLuint);
+    void            setOwner(eGPUResourceType, GLuint, const SGPUOwner&);
+    void            setStorage(GLuint tex, const Vector2D& size, const std::string& format, int bytesPerPixel);
+
+    // warns (once) about resources whose owner is gone
+    void            checkOwners();
+
+    std::string     getReport();
+
+    size_t          m_iBytes = 0;
+
+private:
+    struct SGPUResource {
+        eGPUResourceType    type = GPU_RESOURCE_TEXTURE;
+        GLuint              id = 0;
+        SGPUOwner           owner;
+        Vector2D            size;
+        std::string         format = "";
+        size_t              bytes = 0;
+        std::chrono::steady_clock::time_point created;
+        bool                warned = false;
+    };
+
+    bool            ownerAlive(const SGPUOwner&);
+    std::string     ownerName(const SGPUOwner&);
+
+    static uint64_t key(eGPUResourceType type, GLuint id) {
+        return ((uint64_t)type << 32) | id;
+    }
+
+    std::unordered_map<uint64_t, SGPUResource> m_mResources;
+};
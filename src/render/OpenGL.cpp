@@ -2,6 +2,11 @@
 #include "../Compositor.hpp"
 #include "../helpers/MiscFunctions.hpp"
 
+// gl3ext.h doesn't have it
+#ifndef GL_BGRA_EXT
+#define GL_BGRA_EXT 0x80E1
+#endif
+
 CHyprOpenGLImpl::CHyprOpenGLImpl() {
     RASSERT(eglMakeCurrent(wlr_egl_get_display(g_pCompositor->m_sWLREGL), EGL_NO_SURFACE, EGL_NO_SURFACE, wlr_egl_get_context(g_pCompositor->m_sWLREGL)), "Couldn't unset current EGL!");
 
@@ -12,6 +17,7 @@ CHyprOpenGLImpl::CHyprOpenGLImpl() {
     m_iDRMFD = g_pCompositor->m_iDRMFD;
 
     m_szExtensions = EXTENSIONS;
+    m_bReadBGRA = m_szExtensions.find("GL_EXT_read_format_bgra") != std::string::npos;
 
     Debug::log(LOG, "Creating the Hypr OpenGL Renderer!");
     Debug::log(LOG, "Using: %s", glGetString(GL_VERSION));
@@ -23,59 +29,81 @@ CHyprOpenGLImpl::CHyprOpenGLImpl() {
     Debug::log(WARN, "!RENDERER: Using the legacy GLES2 renderer!");
     #endif
 
+    // Static geometry, the quad is the same for everything
+    glGenBuffers(1, &m_iFullVertsVBO);
+    glBindBuffer(GL_ARRAY_BUFFER, m_iFullVertsVBO);
+    glBufferData(GL_ARRAY_BUFFER, sizeof(fullVerts), fullVerts, GL_STATIC_DRAW);
+
+    glGenBuffers(1, &m_iRectBatchVBO);
+
     // Init shaders
 
-    GLuint prog = createProgram(QUADVERTSRC, QUADFRAGSRC);
-    m_shQUAD.program = prog;
-    m_shQUAD.proj = glGetUniformLocation(prog, "proj");
-    m_shQUAD.color = glGetUniformLocation(prog, "color");
-    m_shQUAD.posAttrib = glGetAttribLocation(prog, "pos");
-    m_shQUAD.texAttrib = glGetAttribLocation(prog, "texcoord");
-
-    prog = createProgram(TEXVERTSRC, TEXFRAGSRCRGBA);
-    m_shRGBA.program = prog;
-    m_shRGBA.proj = glGetUniformLocation(prog, "proj");
-    m_shRGBA.tex = glGetUniformLocation(prog, "tex");
-    m_shRGBA.alpha = glGetUniformLocation(prog, "alpha");
-    m_shRGBA.texAttrib = glGetAttribLocation(prog, "texcoord");
-    m_shRGBA.posAttrib = glGetAttribLocation(prog, "pos");
-    m_shRGBA.discardOpaque = glGetUniformLocation(prog, "discardOpaque");
-
-    prog = createProgram(TEXVERTSRC, TEXFRAGSRCRGBX);
-    m_shRGBX.program = prog;
-    m_shRGBX.tex = glGetUniformLocation(prog, "tex");
-    m_shRGBX.proj = glGetUniformLocation(prog, "proj");
-    m_shRGBX.alpha = glGetUniformLocation(prog, "alpha");
-    m_shRGBX.texAttrib = glGetAttribLocation(prog, "texcoord");
-    m_shRGBX.posAttrib = glGetAttribLocation(prog, "pos");
-    m_shRGBX.discardOpaque = glGetUniformLocation(prog, "discardOpaque");
-
-    prog = createProgram(TEXVERTSRC, TEXFRAGSRCEXT);
-    m_shEXT.program = prog;
-    m_shEXT.tex = glGetUniformLocation(prog, "tex");
-    m_shEXT.proj = glGetUniformLocation(prog, "proj");
-    m_shEXT.alpha = glGetUniformLocation(prog, "alpha");
-    m_shEXT.posAttrib = glGetAttribLocation(prog, "pos");
-    m_shEXT.texAttrib = glGetAttribLocation(prog, "texcoord");
-    m_shEXT.discardOpaque = glGetUniformLocation(prog, "discardOpaque");
-
-    prog = createProgram(TEXVERTSRC, FRAGBLUR1);
-    m_shBLUR1.program = prog;
-    m_shBLUR1.tex = glGetUniformLocation(prog, "tex");
-    m_shBLUR1.alpha = glGetUniformLocation(prog, "alpha");
-    m_shBLUR1.proj = glGetUniformLocation(prog, "proj");
-    m_shBLUR1.posAttrib = glGetAttribLocation(prog, "pos");
-    m_shBLUR1.texAttrib = glGetAttribLocation(prog, "texcoord");
-
-    prog = createProgram(TEXVERTSRC, FRAGBLUR2);
-    m_shBLUR2.program = prog;
-    m_shBLUR2.tex = glGetUniformLocation(prog, "tex");
-    m_shBLUR2.alpha = glGetUniformLocation(prog, "alpha");
-    m_shBLUR2.proj = glGetUniformLocation(prog, "proj");
-    m_shBLUR2.posAttrib = glGetAttribLocation(prog, "pos");
-    m_shBLUR2.texAttrib = glGetAttribLocation(prog, "texcoord");
-
-    Debug::log(LOG, "Shaders initialized successfully.");
+    m_sShaderCache.init();
+
+    const auto SHADERSBEGIN = std::chrono::steady_clock::now();
+
+    // the first frame only needs the square, non-discarding ones (wallpaper, rects).
+    // Everything else is built on the shader thread, or waited for if a frame needs it sooner
+    for (int corners = 0; corners < SHADER_CORNERS_COUNT; ++corners) {
+        addShader(&m_shQUAD[corners].asyncJob, QUADVERTSRC, SHADER_VARIANT_DEFINES(corners, false) + QUADFRAGSRC, corners != SHADER_CORNERS_SQUARE, [this, corners](GLuint prog) {
+            m_shQUAD[corners].program = prog;
+            m_shQUAD[corners].proj = glGetUniformLocation(prog, "proj");
+            m_shQUAD[corners].color = glGetUniformLocation(prog, "color");
+            m_shQUAD[corners].posAttrib = glGetAttribLocation(prog, "pos");
+            m_shQUAD[corners].texAttrib = glGetAttribLocation(prog, "texcoord");
+            m_shQUAD[corners].fullSize = glGetUniformLocation(prog, "fullSize");
+            m_shQUAD[corners].radius = glGetUniformLocation(prog, "radius");
+            createVAO(&m_shQUAD[corners].vao, m_shQUAD[corners].posAttrib, m_shQUAD[corners].texAttrib);
+        });
+
+        for (int discardOpaque = 0; discardOpaque < 2; ++discardOpaque) {
+            const auto DEFINES = SHADER_VARIANT_DEFINES(corners, discardOpaque);
+            const bool ASYNC = corners != SHADER_CORNERS_SQUARE || discardOpaque;
+            addTexShader(&m_shRGBA[corners][discardOpaque], DEFINES + TEXFRAGSRCRGBA, ASYNC);
+            addTexShader(&m_shRGBX[corners][discardOpaque], DEFINES + TEXFRAGSRCRGBX, ASYNC);
+            addTexShader(&m_shEXT[corners][discardOpaque], DEFINES + TEXFRAGSRCEXT, true);
+        }
+    }
+
+    for (const auto& [PSHADER, FRAG] : {std::make_pair(&m_shBLUR1, FRAGBLUR1), std::make_pair(&m_shBLUR2, FRAGBLUR2)}) {
+        addShader(&PSHADER->asyncJob, TEXVERTSRC, FRAG, true, [this, PSHADER = PSHADER](GLuint prog) {
+            PSHADER->program = prog;
+            PSHADER->tex = glGetUniformLocation(prog, "tex");
+            PSHADER->alpha = glGetUniformLocation(prog, "alpha");
+            PSHADER->proj = glGetUniformLocation(prog, "proj");
+            PSHADER->posAttrib = glGetAttribLocation(prog, "pos");
+            PSHADER->texAttrib = glGetAttribLocation(prog, "texcoord");
+            PSHADER->radius = glGetUniformLocation(prog, "radius");
+            PSHADER->halfpixel = glGetUniformLocation(prog, "halfpixel");
+            PSHADER->texscale = glGetUniformLocation(prog, "texscale");
+            createVAO(&PSHADER->vao, PSHADER->posAttrib, PSHADER->texAttrib);
+        });
+    }
+
+    GLuint prog = createProgram(QUADBATCHVERTSRC, QUADBATCHFRAGSRC);
+    m_shQUADBATCH.program = prog;
+    m_shQUADBATCH.posAttrib = glGetAttribLocation(prog, "pos");
+    m_shQUADBATCH.colorAttrib = glGetAttribLocation(prog, "color");
+
+#ifndef GLES2
+    glGenVertexArrays(1, &m_shQUADBATCH.vao);
+    glBindVertexArray(m_shQUADBATCH.vao);
+    glBindBuffer(GL_ARRAY_BUFFER, m_iRectBatchVBO);
+    glVertexAttribPointer(m_shQUADBATCH.posAttrib, 2, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)0);
+    glVertexAttribPointer(m_shQUADBATCH.colorAttrib, 4, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)(2 * sizeof(float)));
+    glEnableVertexAttribArray(m_shQUADBATCH.posAttrib);
+    glEnableVertexAttribArray(m_shQUADBATCH.colorAttrib);
+    glBindVertexArray(0);
+#endif
+
+    // wlr uses client-side arrays, don't leave a buffer bound
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    m_fShaderInitMs = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - SHADERSBEGIN).count() / 1000.f;
+
+    Debug::log(LOG, "Shaders initialized in %.2fms (cache: %i hits, %i misses), %i more building in the background.", m_fShaderInitMs, m_sShaderCache.m_iHits.load(), m_sShaderCache.m_iMisses.load(), (int)m_vShaderJobs.size());
+
+    startShaderThread();
 
     // End shaders
 
@@ -88,7 +116,214 @@ CHyprOpenGLImpl::CHyprOpenGLImpl() {
     // Done!
 }
 
+CHyprOpenGLImpl::~CHyprOpenGLImpl() {
+    m_bShaderThreadExit = true;
+
+    if (m_tShaderThread.joinable())
+        m_tShaderThread.join();
+}
+
+void CHyprOpenGLImpl::createVAO(GLuint* vao, GLint posAttrib, GLint texAttrib) {
+#ifndef GLES2
+    glGenVertexArrays(1, vao);
+    glBindVertexArray(*vao);
+
+    glBindBuffer(GL_ARRAY_BUFFER, m_iFullVertsVBO);
+    glVertexAttribPointer(posAttrib, 2, GL_FLOAT, GL_FALSE, 0, (void*)0);
+    glVertexAttribPointer(texAttrib, 2, GL_FLOAT, GL_FALSE, 0, (void*)0);
+
+    glEnableVertexAttribArray(posAttrib);
+    glEnableVertexAttribArray(texAttrib);
+
+    glBindVertexArray(0);
+#endif
+}
+
+void CHyprOpenGLImpl::bindGeometry(GLuint vao, GLint posAttrib, GLint texAttrib) {
+#ifndef GLES2
+    m_sGLState.bindVertexArray(vao);
+#else
+    // no VAOs on GLES2, but we can still keep the verts on the GPU
+    m_sGLState.bindArrayBuffer(m_iFullVertsVBO);
+
+    glVertexAttribPointer(posAttrib, 2, GL_FLOAT, GL_FALSE, 0, (void*)0);
+    glVertexAttribPointer(texAttrib, 2, GL_FLOAT, GL_FALSE, 0, (void*)0);
+
+    m_sGLState.setVertexAttribArrays(posAttrib, texAttrib);
+#endif
+}
+
+void CHyprOpenGLImpl::addTexShader(CShader* pShader, const std::string& frag, bool async) {
+    addShader(&pShader->asyncJob, TEXVERTSRC, frag, async, [this, pShader](GLuint prog) {
+        pShader->program = prog;
+        pShader->proj = glGetUniformLocation(prog, "proj");
+        pShader->tex = glGetUniformLocation(prog, "tex");
+        pShader->alpha = glGetUniformLocation(prog, "alpha");
+        pShader->posAttrib = glGetAttribLocation(prog, "pos");
+        pShader->texAttrib = glGetAttribLocation(prog, "texcoord");
+        pShader->fullSize = glGetUniformLocation(prog, "fullSize");
+        pShader->radius = glGetUniformLocation(prog, "radius");
+        createVAO(&pShader->vao, pShader->posAttrib, pShader->texAttrib);
+    });
+}
+
+void CHyprOpenGLImpl::addShader(int* pAsyncJob, const std::string& vert, const std::string& frag, bool async, std::function<void(GLuint)> setup) {
+    if (!async) {
+        setup(createProgram(vert, frag));
+        *pAsyncJob = -1;
+        return;
+    }
+
+    *pAsyncJob = m_vShaderJobs.size();
+    m_vShaderJobs.push_back({vert, frag, 0, false, pAsyncJob, setup});
+}
+
+EGLContext CHyprOpenGLImpl::createSharedContext() {
+    const auto EGLDISPLAY = wlr_egl_get_display(g_pCompositor->m_sWLREGL);
+    const auto PEXTENSIONS = eglQueryString(EGLDISPLAY, EGL_EXTENSIONS);
+    const std::string EXTENSIONS = PEXTENSIONS ? PEXTENSIONS : "";
+
+    // wlr's context has no config and is never bound to a surface, same here
+    if (EXTENSIONS.find("EGL_KHR_no_config_context") == std::string::npos || EXTENSIONS.find("EGL_KHR_surfaceless_context") == std::string::npos)
+        return EGL_NO_CONTEXT;
+
+    eglBindAPI(EGL_OPENGL_ES_API);
+
+    // sharing needs the same reset strategy as wlr's context, which uses robustness if it's there
+    if (EXTENSIONS.find("EGL_EXT_create_context_robustness") != std::string::npos) {
+        const EGLint ATTRIBS[] = {EGL_CONTEXT_CLIENT_VERSION, 2, EGL_CONTEXT_OPENGL_RESET_NOTIFICATION_STRATEGY_EXT, EGL_LOSE_CONTEXT_ON_RESET_EXT, EGL_NONE};
+        const auto CONTEXT = eglCreateContext(EGLDISPLAY, EGL_NO_CONFIG_KHR, wlr_egl_get_context(g_pCompositor->m_sWLREGL), ATTRIBS);
+
+        if (CONTEXT != EGL_NO_CONTEXT)
+            return CONTEXT;
+    }
+
+    const EGLint ATTRIBS[] = {EGL_CONTEXT_CLIENT_VERSION, 2, EGL_NONE};
+    return eglCreateContext(EGLDISPLAY, EGL_NO_CONFIG_KHR, wlr_egl_get_context(g_pCompositor->m_sWLREGL), ATTRIBS);
+}
+
+void CHyprOpenGLImpl::startShaderThread() {
+    m_iShaderJobsPending = m_vShaderJobs.size();
+
+    if (m_vShaderJobs.empty())
+        return;
+
+    const auto EGLDISPLAY = wlr_egl_get_display(g_pCompositor->m_sWLREGL);
+    const auto CONTEXT = createSharedContext();
+
+    if (CONTEXT == EGL_NO_CONTEXT) {
+        Debug::log(WARN, "Couldn't create a shared EGL context, building all shaders now");
+
+        buildShaderJobs();
+
+        for (size_t i = 0; i < m_vShaderJobs.size(); ++i)
+            finishShaderJob(i, false);
+
+        m_iShadersBuiltAsync = 0;
+
+        return;
+    }
+
+    m_tShaderThread = std::thread([this, EGLDISPLAY, CONTEXT]() {
+        // the API is per thread
+        eglBindAPI(EGL_OPENGL_ES_API);
+
+        // if this fails, the main thread builds them when they're needed
+        if (eglMakeCurrent(EGLDISPLAY, EGL_NO_SURFACE, EGL_NO_SURFACE, CONTEXT)) {
+            buildShaderJobs();
+            eglMakeCurrent(EGLDISPLAY, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+        } else {
+            std::lock_guard<std::mutex> lg(m_mShaderJobsMutex);
+
+            for (auto& job : m_vShaderJobs)
+                job.built = true;
+        }
+
+        m_cvShaderJobs.notify_all();
+
+        eglDestroyContext(EGLDISPLAY, CONTEXT);
+    });
+}
+
+void CHyprOpenGLImpl::buildShaderJobs() {
+    for (auto& job : m_vShaderJobs) {
+        // exiting, nobody's going to wait for these
+        if (m_bShaderThreadExit)
+            return;
+
+        const auto PROG = createProgram(job.vert, job.frag);
+
+        // the other context can only use it once it's really done
+        glFinish();
+
+        {
+            std::lock_guard<std::mutex> lg(m_mShaderJobsMutex);
+            job.program = PROG;
+            job.built = true;
+        }
+
+        m_cvShaderJobs.notify_all();
+    }
+}
+
+bool CHyprOpenGLImpl::finishShaderJob(int index, bool wait) {
+    auto& job = m_vShaderJobs[index];
+
+    {
+        std::unique_lock<std::mutex> lk(m_mShaderJobsMutex);
+
+        if (!job.built) {
+            if (!wait)
+                return false;
+
+            m_iShaderWaits++;
+            Debug::log(WARN, "A frame has to wait for a shader that's still building");
+
+            m_cvShaderJobs.wait(lk, [&] { return job.built; });
+        }
+    }
+
+    // the thread couldn't use its context
+    if (!job.program)
+        job.program = createProgram(job.vert, job.frag);
+    else
+        m_iShadersBuiltAsync++;
+
+    job.setup(job.program);
+    *job.pAsyncJob = -1;
+
+    // the VAO setup can happen mid-frame and changes the bindings behind the state cache's back
+    m_sGLState.invalidate();
+
+    if (--m_iShaderJobsPending == 0 && m_tShaderThread.joinable()) {
+        m_tShaderThread.join();
+        Debug::log(LOG, "All shaders ready, %i were built in the background.", m_iShadersBuiltAsync);
+    }
+
+    return true;
+}
+
+void CHyprOpenGLImpl::finishShaderJobs() {
+    if (m_iShaderJobsPending == 0)
+        return;
+
+    for (size_t i = 0; i < m_vShaderJobs.size(); ++i) {
+        if (*m_vShaderJobs[i].pAsyncJob != -1)
+            finishShaderJob(i, false);
+    }
+}
+
+eShaderCorners CHyprOpenGLImpl::getShaderCorners(int round, bool allowAA) {
+    if (round == 0)
+        return SHADER_CORNERS_SQUARE;
+
+    return allowAA && g_pConfigManager->getInt("decoration:multisample_edges") == 1 ? SHADER_CORNERS_ROUNDED_AA : SHADER_CORNERS_ROUNDED;
+}
+
 GLuint CHyprOpenGLImpl::createProgram(const std::string& vert, const std::string& frag) {
+    if (const auto CACHED = m_sShaderCache.load(vert, frag); CACHED)
+        return CACHED;
+
     auto vertCompiled = compileShader(GL_VERTEX_SHADER, vert);
     RASSERT(vertCompiled, "Compiling shader failed. VERTEX NULL! Shader source:\n\n%s", vert.c_str());
 
@@ -98,6 +333,10 @@ GLuint CHyprOpenGLImpl::createProgram(const std::string& vert, const std::string
     auto prog = glCreateProgram();
     glAttachShader(prog, vertCompiled);
     glAttachShader(prog, fragCompiled);
+#ifndef GLES2
+    if (m_sShaderCache.m_bEnabled)
+        glProgramParameteri(prog, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+#endif
     glLinkProgram(prog);
 
     glDetachShader(prog, vertCompiled);
@@ -109,6 +348,8 @@ GLuint CHyprOpenGLImpl::createProgram(const std::string& vert, const std::string
     glGetProgramiv(prog, GL_LINK_STATUS, &ok);
     RASSERT(ok != GL_FALSE, "createProgram() failed! GL_LINK_STATUS not OK!");
 
+    m_sShaderCache.save(prog, vert, frag);
+
     return prog;
 }
 
@@ -130,26 +371,39 @@ GLuint CHyprOpenGLImpl::compileShader(const GLuint& type, std::string src) {
 void CHyprOpenGLImpl::begin(SMonitor* pMonitor, pixman_region32_t* pDamage, bool fake) {
     m_RenderData.pMonitor = pMonitor;
 
+    // pick up whatever the shader thread finished, before anything's bound
+    finishShaderJobs();
+
+    // wlr might've touched the state since our last frame
+    m_sGLState.invalidate();
+    if (!fake)
+        m_sGLState.resetCounters();
+
+    // we never leave the stencil on between draws
+    m_sGLState.setCapability(GL_STENCIL_TEST, false);
+
     glViewport(0, 0, pMonitor->vecPixelSize.x, pMonitor->vecPixelSize.y);
 
     wlr_matrix_projection(m_RenderData.projection, pMonitor->vecPixelSize.x, pMonitor->vecPixelSize.y, WL_OUTPUT_TRANSFORM_NORMAL);  // TODO: this is deprecated
 
-    glBlendFunc(GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+    m_sGLState.blendFunc(GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
 
     glGetIntegerv(GL_FRAMEBUFFER_BINDING, &m_iCurrentOutputFb);
     m_iWLROutputFb = m_iCurrentOutputFb;
 
-    // ensure a framebuffer for the monitor exists
+    // ensure a framebuffer for the monitor exists.
+    // The blur ones are made when blur first needs them, see allocBlurBuffers
     if (m_mMonitorRenderResources.find(pMonitor) == m_mMonitorRenderResources.end() || m_mMonitorRenderResources[pMonitor].primaryFB.m_Size != pMonitor->vecPixelSize) {
-        m_mMonitorRenderResources[pMonitor].stencilTex.allocate();
+        const auto PMONITORDATA = &m_mMonitorRenderResources[pMonitor];
+
+        PMONITORDATA->stencilTex.allocate({GPU_OWNER_MONITOR, pMonitor, "stencil"});
 
-        m_mMonitorRenderResources[pMonitor].primaryFB.m_pStencilTex = &m_mMonitorRenderResources[pMonitor].stencilTex;
-        m_mMonitorRenderResources[pMonitor].mirrorFB.m_pStencilTex = &m_mMonitorRenderResources[pMonitor].stencilTex;
-        m_mMonitorRenderResources[pMonitor].mirrorSwapFB.m_pStencilTex = &m_mMonitorRenderResources[pMonitor].stencilTex;
+        PMONITORDATA->primaryFB.m_pStencilTex = &PMONITORDATA->stencilTex;
+        PMONITORDATA->primaryFB.m_sOwner = {GPU_OWNER_MONITOR, pMonitor, "primary"};
+        PMONITORDATA->primaryFB.alloc(pMonitor->vecPixelSize.x, pMonitor->vecPixelSize.y);
 
-        m_mMonitorRenderResources[pMonitor].primaryFB.alloc(pMonitor->vecPixelSize.x, pMonitor->vecPixelSize.y);
-        m_mMonitorRenderResources[pMonitor].mirrorFB.alloc(pMonitor->vecPixelSize.x, pMonitor->vecPixelSize.y);
-        m_mMonitorRenderResources[pMonitor].mirrorSwapFB.alloc(pMonitor->vecPixelSize.x, pMonitor->vecPixelSize.y);
+        // wrong size now
+        releaseBlurBuffers(PMONITORDATA);
 
         createBGTextureForMonitor(pMonitor);
     }
@@ -163,6 +417,12 @@ void CHyprOpenGLImpl::begin(SMonitor* pMonitor, pixman_region32_t* pDamage, bool
 }
 
 void CHyprOpenGLImpl::end() {
+    flushRectBatch();
+
+    // software cursors are rendered by wlr after this, onto the wlr buffer,
+    // so that the primary FB never has them (see renderMonitor)
+    m_sGLState.invalidate();
+
     // end the render, copy the data to the WLR framebuffer
     if (!m_bFakeFrame) {
         glBindFramebuffer(GL_FRAMEBUFFER, m_iWLROutputFb);
@@ -177,8 +437,19 @@ void CHyprOpenGLImpl::end() {
         renderTexture(m_mMonitorRenderResources[m_RenderData.pMonitor].primaryFB.m_cTex, &monbox, 255.f, 0);
 
         m_bEndFrame = false;
+
+        m_mMonitorRenderResources[m_RenderData.pMonitor].glCallsIssued = m_sGLState.m_iCallsIssued;
+        m_mMonitorRenderResources[m_RenderData.pMonitor].glCallsElided = m_sGLState.m_iCallsElided;
+        m_mMonitorRenderResources[m_RenderData.pMonitor].glDrawCalls = m_sGLState.m_iDrawCalls;
+
+        if (m_fFirstFrameMs < 0) {
+            m_fFirstFrameMs = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - g_pCompositor->m_tStartTime).count() / 1000.f;
+            Debug::log(LOG, "First frame after %.2fms (shader cache: %i hits, %i misses, %i built in the background)", m_fFirstFrameMs, m_sShaderCache.m_iHits.load(), m_sShaderCache.m_iMisses.load(), m_iShadersBuiltAsync);
+        }
     }
 
+    releaseStateForWLR();
+
     // reset our data
     m_RenderData.pMonitor = nullptr;
     m_iWLROutputFb = 0;
@@ -187,6 +458,8 @@ void CHyprOpenGLImpl::end() {
 void CHyprOpenGLImpl::clear(const CColor& color) {
     RASSERT(m_RenderData.pMonitor, "Tried to render without begin()!");
 
+    flushRectBatch();
+
     glClearColor(color.r / 255.f, color.g / 255.f, color.b / 255.f, color.a / 255.f);
 
     if (pixman_region32_not_empty(m_RenderData.pDamage)) {
@@ -205,7 +478,7 @@ void CHyprOpenGLImpl::scissor(const wlr_box* pBox) {
     RASSERT(m_RenderData.pMonitor, "Tried to scissor without begin()!");
 
     if (!pBox) {
-        glDisable(GL_SCISSOR_TEST);
+        m_sGLState.setCapability(GL_SCISSOR_TEST, false);
         return;
     }
 
@@ -218,14 +491,14 @@ void CHyprOpenGLImpl::scissor(const wlr_box* pBox) {
     wlr_box_transform(&newBox, &newBox, TR, w, h);
 
     glScissor(newBox.x, newBox.y, newBox.width, newBox.height);
-    glEnable(GL_SCISSOR_TEST);
+    m_sGLState.setCapability(GL_SCISSOR_TEST, true);
 }
 
 void CHyprOpenGLImpl::scissor(const pixman_box32* pBox) {
     RASSERT(m_RenderData.pMonitor, "Tried to scissor without begin()!");
 
     if (!pBox) {
-        glDisable(GL_SCISSOR_TEST);
+        m_sGLState.setCapability(GL_SCISSOR_TEST, false);
         return;
     }
 
@@ -250,45 +523,53 @@ void CHyprOpenGLImpl::renderRect(wlr_box* box, const CColor& col, int round) {
     wlr_matrix_multiply(glMatrix, m_RenderData.projection, matrix);
     wlr_matrix_multiply(glMatrix, matrixFlip180, glMatrix);
 
+    // plain rects don't need the rounding shader, we can collect them
+    // and draw all of them at once
+    if (round == 0 && m_sGLState.isKnownDisabled(GL_STENCIL_TEST)) {
+        const float COL[4] = {col.r / 255.f, col.g / 255.f, col.b / 255.f, col.a / 255.f};
+        const float CORNERS[6][2] = {{0, 0}, {1, 0}, {0, 1}, {1, 0}, {1, 1}, {0, 1}};
+
+        for (auto& c : CORNERS) {
+            m_vRectBatch.push_back(glMatrix[0] * c[0] + glMatrix[1] * c[1] + glMatrix[2]);
+            m_vRectBatch.push_back(glMatrix[3] * c[0] + glMatrix[4] * c[1] + glMatrix[5]);
+            m_vRectBatch.insert(m_vRectBatch.end(), COL, COL + 4);
+        }
+
+        return;
+    }
+
+    flushRectBatch();
+
     wlr_matrix_transpose(glMatrix, glMatrix);
 
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    m_sGLState.setCapability(GL_BLEND, true);
+    m_sGLState.blendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
-    glUseProgram(m_shQUAD.program);
+    const auto PSHADER = &m_shQUAD[getShaderCorners(round, true)];
 
-    glUniformMatrix3fv(m_shQUAD.proj, 1, GL_FALSE, glMatrix);
-    glUniform4f(m_shQUAD.color, col.r / 255.f, col.g / 255.f, col.b / 255.f, col.a / 255.f);
+    if (PSHADER->asyncJob != -1)
+        finishShaderJob(PSHADER->asyncJob, true);
 
-    const auto TOPLEFT = Vector2D(round, round);
-    const auto BOTTOMRIGHT = Vector2D(box->width - round, box->height - round);
-    const auto FULLSIZE = Vector2D(box->width, box->height);
+    m_sGLState.useProgram(PSHADER->program);
 
-    // Rounded corners
-    glUniform2f(glGetUniformLocation(m_shQUAD.program, "topLeft"), (float)TOPLEFT.x, (float)TOPLEFT.y);
-    glUniform2f(glGetUniformLocation(m_shQUAD.program, "bottomRight"), (float)BOTTOMRIGHT.x, (float)BOTTOMRIGHT.y);
-    glUniform2f(glGetUniformLocation(m_shQUAD.program, "fullSize"), (float)FULLSIZE.x, (float)FULLSIZE.y);
-    glUniform1f(glGetUniformLocation(m_shQUAD.program, "radius"), round);
-    glUniform1i(glGetUniformLocation(m_shQUAD.program, "primitiveMultisample"), (int)(g_pConfigManager->getInt("decoration:multisample_edges") == 1 && round != 0));
+    glUniformMatrix3fv(PSHADER->proj, 1, GL_FALSE, glMatrix);
+    glUniform4f(PSHADER->color, col.r / 255.f, col.g / 255.f, col.b / 255.f, col.a / 255.f);
 
-    glVertexAttribPointer(m_shQUAD.posAttrib, 2, GL_FLOAT, GL_FALSE, 0, fullVerts);
-    glVertexAttribPointer(m_shQUAD.texAttrib, 2, GL_FLOAT, GL_FALSE, 0, fullVerts);
+    // Rounded corners
+    glUniform2f(PSHADER->fullSize, (float)box->width, (float)box->height);
+    glUniform1f(PSHADER->radius, round);
 
-    glEnableVertexAttribArray(m_shQUAD.posAttrib);
-    glEnableVertexAttribArray(m_shQUAD.texAttrib);
+    bindGeometry(PSHADER->vao, PSHADER->posAttrib, PSHADER->texAttrib);
 
     if (pixman_region32_not_empty(m_RenderData.pDamage)) {
         PIXMAN_DAMAGE_FOREACH(m_RenderData.pDamage) {
             const auto RECT = RECTSARR[i];
             scissor(&RECT);
-            glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+            m_sGLState.drawArrays(GL_TRIANGLE_STRIP, 0, 4);
         }
     }
 
-    glDisableVertexAttribArray(m_shQUAD.posAttrib);
-    glDisableVertexAttribArray(m_shQUAD.texAttrib);
-
-    glBlendFunc(GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+    m_sGLState.blendFunc(GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
 }
 
 void CHyprOpenGLImpl::renderTexture(wlr_texture* tex, wlr_box* pBox, float alpha, int round) {
@@ -309,6 +590,8 @@ void CHyprOpenGLImpl::renderTextureInternalWithDamage(const CTexture& tex, wlr_b
     RASSERT(m_RenderData.pMonitor, "Tried to render texture without begin()!");
     RASSERT((tex.m_iTexID > 0), "Attempted to draw NULL texture!");
 
+    flushRectBatch();
+
     // get transform
     const auto TRANSFORM = wlr_output_transform_invert(!m_bEndFrame ? WL_OUTPUT_TRANSFORM_NORMAL : m_RenderData.pMonitor->transform);
     float matrix[9];
@@ -322,61 +605,54 @@ void CHyprOpenGLImpl::renderTextureInternalWithDamage(const CTexture& tex, wlr_b
 
     CShader* shader = nullptr;
 
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+    m_sGLState.setCapability(GL_BLEND, true);
+    m_sGLState.blendFunc(GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+
+    const auto CORNERS = getShaderCorners(round, !border && !noAA);
 
     switch (tex.m_iType) {
         case TEXTURE_RGBA:
-            shader = &m_shRGBA;
+            shader = &m_shRGBA[CORNERS][discardOpaque];
             break;
         case TEXTURE_RGBX:
-            shader = &m_shRGBX;
+            shader = &m_shRGBX[CORNERS][discardOpaque];
             break;
         case TEXTURE_EXTERNAL:
-            shader = &m_shEXT;
+            shader = &m_shEXT[CORNERS][discardOpaque];
             break;
         default:
             RASSERT(false, "tex.m_iTarget unsupported!");
     }
 
-    glActiveTexture(GL_TEXTURE0);
-    glBindTexture(tex.m_iTarget, tex.m_iTexID);
+    m_sGLState.activeTexture(GL_TEXTURE0);
+    m_sGLState.bindTexture(tex.m_iTarget, tex.m_iTexID);
+
+    m_sGLState.texParameteri(tex.m_iTarget, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
 
-    glTexParameteri(tex.m_iTarget, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    if (shader->asyncJob != -1)
+        finishShaderJob(shader->asyncJob, true);
 
-    glUseProgram(shader->program);
+    m_sGLState.useProgram(shader->program);
 
     glUniformMatrix3fv(shader->proj, 1, GL_FALSE, glMatrix);
     glUniform1i(shader->tex, 0);
     glUniform1f(shader->alpha, alpha / 255.f);
-    glUniform1i(shader->discardOpaque, (int)discardOpaque);
 
     // round is in px
-    // so we need to do some maf
-
-    const auto TOPLEFT = Vector2D(round, round);
-    const auto BOTTOMRIGHT = Vector2D(tex.m_vSize.x - round, tex.m_vSize.y - round);
     const auto FULLSIZE = tex.m_vSize;
 
     // Rounded corners
-    glUniform2f(glGetUniformLocation(shader->program, "topLeft"), (float)TOPLEFT.x, (float)TOPLEFT.y);
-    glUniform2f(glGetUniformLocation(shader->program, "bottomRight"), (float)BOTTOMRIGHT.x, (float)BOTTOMRIGHT.y);
-    glUniform2f(glGetUniformLocation(shader->program, "fullSize"), (float)FULLSIZE.x, (float)FULLSIZE.y);
-    glUniform1f(glGetUniformLocation(shader->program, "radius"), round);
-    glUniform1i(glGetUniformLocation(shader->program, "primitiveMultisample"), (int)(g_pConfigManager->getInt("decoration:multisample_edges") == 1 && round != 0 && !border && !noAA));
+    glUniform2f(shader->fullSize, (float)FULLSIZE.x, (float)FULLSIZE.y);
+    glUniform1f(shader->radius, round);
 
-    glVertexAttribPointer(shader->posAttrib, 2, GL_FLOAT, GL_FALSE, 0, fullVerts);
-    glVertexAttribPointer(shader->texAttrib, 2, GL_FLOAT, GL_FALSE, 0, fullVerts);
-
-    glEnableVertexAttribArray(shader->posAttrib);
-    glEnableVertexAttribArray(shader->texAttrib);
+    bindGeometry(shader->vao, shader->posAttrib, shader->texAttrib);
 
     // stencil for when we want a border
     if (border) {
         glClearStencil(0);
         glClear(GL_STENCIL_BUFFER_BIT);
 
-        glEnable(GL_STENCIL_TEST);
+        m_sGLState.setCapability(GL_STENCIL_TEST, true);
 
         glStencilFunc(GL_ALWAYS, 1, -1);
         glStencilOp(GL_REPLACE, GL_REPLACE, GL_REPLACE);
@@ -386,7 +662,7 @@ void CHyprOpenGLImpl::renderTextureInternalWithDamage(const CTexture& tex, wlr_b
         PIXMAN_DAMAGE_FOREACH(m_RenderData.pDamage) {
             const auto RECT = RECTSARR[i];
             scissor(&RECT);
-            glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+            m_sGLState.drawArrays(GL_TRIANGLE_STRIP, 0, 4);
         }
     }
 
@@ -395,11 +671,6 @@ void CHyprOpenGLImpl::renderTextureInternalWithDamage(const CTexture& tex, wlr_b
         glStencilOp(GL_KEEP, GL_KEEP, GL_REPLACE);
     }
 
-    glDisableVertexAttribArray(shader->posAttrib);
-    glDisableVertexAttribArray(shader->texAttrib);
-
-    glBindTexture(tex.m_iTarget, 0);
-
     // if border draw
     // we dont disable stencil here if we havent touched it. 
     // some other func might be using it.
@@ -409,7 +680,7 @@ void CHyprOpenGLImpl::renderTextureInternalWithDamage(const CTexture& tex, wlr_b
         renderBorder(pBox, BORDERCOL, g_pConfigManager->getInt("general:border_size"), round);
         glStencilMask(-1);
         glStencilFunc(GL_ALWAYS, 1, 0xFF);
-        glDisable(GL_STENCIL_TEST);
+        m_sGLState.setCapability(GL_STENCIL_TEST, false);
     }
 }
 
@@ -419,8 +690,10 @@ void CHyprOpenGLImpl::renderTextureInternalWithDamage(const CTexture& tex, wlr_b
 // Dual (or more) kawase blur
 CFramebuffer* CHyprOpenGLImpl::blurMainFramebufferWithDamage(float a, wlr_box* pBox, pixman_region32_t* originalDamage) {
 
-    glDisable(GL_BLEND);
-    glDisable(GL_STENCIL_TEST);
+    flushRectBatch();
+
+    m_sGLState.setCapability(GL_BLEND, false);
+    m_sGLState.setCapability(GL_STENCIL_TEST, false);
 
     // get transforms for the full monitor
     const auto TRANSFORM = wlr_output_transform_invert(WL_OUTPUT_TRANSFORM_NORMAL);
@@ -443,6 +716,8 @@ CFramebuffer* CHyprOpenGLImpl::blurMainFramebufferWithDamage(float a, wlr_box* p
     pixman_region32_copy(&damage, originalDamage);
     wlr_region_expand(&damage, &damage, pow(2, BLURPASSES) * BLURSIZE);
 
+    allocBlurBuffers();
+
     // helper
     const auto PMIRRORFB = &m_mMonitorRenderResources[m_RenderData.pMonitor].mirrorFB;
     const auto PMIRRORSWAPFB = &m_mMonitorRenderResources[m_RenderData.pMonitor].mirrorSwapFB;
@@ -456,41 +731,41 @@ CFramebuffer* CHyprOpenGLImpl::blurMainFramebufferWithDamage(float a, wlr_box* p
         else
             PMIRRORFB->bind();
 
-        glActiveTexture(GL_TEXTURE0);
+        m_sGLState.activeTexture(GL_TEXTURE0);
+
+        m_sGLState.bindTexture(currentRenderToFB->m_cTex.m_iTarget, currentRenderToFB->m_cTex.m_iTexID);
 
-        glBindTexture(currentRenderToFB->m_cTex.m_iTarget, currentRenderToFB->m_cTex.m_iTexID);
+        m_sGLState.texParameteri(currentRenderToFB->m_cTex.m_iTarget, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
 
-        glTexParameteri(currentRenderToFB->m_cTex.m_iTarget, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+        if (pShader->asyncJob != -1)
+            finishShaderJob(pShader->asyncJob, true);
 
-        glUseProgram(pShader->program);
+        m_sGLState.useProgram(pShader->program);
+
+        // the mirror is half the size, so coords into it have to be scaled up
+        const auto TEXSCALE = currentRenderToFB == PMIRRORFB ? Vector2D(m_RenderData.pMonitor->vecPixelSize.x / PMIRRORFB->m_Size.x, m_RenderData.pMonitor->vecPixelSize.y / PMIRRORFB->m_Size.y) : Vector2D(1, 1);
 
         // prep two shaders
         glUniformMatrix3fv(pShader->proj, 1, GL_FALSE, glMatrix);
-        glUniform1f(glGetUniformLocation(pShader->program, "radius"), BLURSIZE * (a / 255.f));  // this makes the blursize change with a
+        glUniform1f(pShader->radius, BLURSIZE * (a / 255.f));  // this makes the blursize change with a
+        glUniform2f(pShader->texscale, TEXSCALE.x, TEXSCALE.y);
         if (pShader == &m_shBLUR1)
-            glUniform2f(glGetUniformLocation(m_shBLUR1.program, "halfpixel"), 0.5f / (m_RenderData.pMonitor->vecPixelSize.x / 2.f), 0.5f / (m_RenderData.pMonitor->vecPixelSize.y / 2.f));
+            glUniform2f(m_shBLUR1.halfpixel, TEXSCALE.x * 0.5f / (m_RenderData.pMonitor->vecPixelSize.x / 2.f), TEXSCALE.y * 0.5f / (m_RenderData.pMonitor->vecPixelSize.y / 2.f));
         else
-            glUniform2f(glGetUniformLocation(m_shBLUR2.program, "halfpixel"), 0.5f / (m_RenderData.pMonitor->vecPixelSize.x * 2.f), 0.5f / (m_RenderData.pMonitor->vecPixelSize.y * 2.f));
+            glUniform2f(m_shBLUR2.halfpixel, TEXSCALE.x * 0.5f / (m_RenderData.pMonitor->vecPixelSize.x * 2.f), TEXSCALE.y * 0.5f / (m_RenderData.pMonitor->vecPixelSize.y * 2.f));
         glUniform1i(pShader->tex, 0);
 
-        glVertexAttribPointer(pShader->posAttrib, 2, GL_FLOAT, GL_FALSE, 0, fullVerts);
-        glVertexAttribPointer(pShader->texAttrib, 2, GL_FLOAT, GL_FALSE, 0, fullVerts);
-
-        glEnableVertexAttribArray(pShader->posAttrib);
-        glEnableVertexAttribArray(pShader->texAttrib);
+        bindGeometry(pShader->vao, pShader->posAttrib, pShader->texAttrib);
 
         if (pixman_region32_not_empty(pDamage)) {
             PIXMAN_DAMAGE_FOREACH(pDamage) {
                 const auto RECT = RECTSARR[i];
                 scissor(&RECT);
 
-                glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+                m_sGLState.drawArrays(GL_TRIANGLE_STRIP, 0, 4);
             }
         }
 
-        glDisableVertexAttribArray(pShader->posAttrib);
-        glDisableVertexAttribArray(pShader->texAttrib);
-
         if (currentRenderToFB != PMIRRORFB)
             currentRenderToFB = PMIRRORFB;
         else
@@ -500,7 +775,7 @@ CFramebuffer* CHyprOpenGLImpl::blurMainFramebufferWithDamage(float a, wlr_box* p
     // draw the things.
     // first draw is prim -> mirr
     PMIRRORFB->bind();
-    glBindTexture(m_mMonitorRenderResources[m_RenderData.pMonitor].primaryFB.m_cTex.m_iTarget, m_mMonitorRenderResources[m_RenderData.pMonitor].primaryFB.m_cTex.m_iTexID);
+    m_sGLState.bindTexture(m_mMonitorRenderResources[m_RenderData.pMonitor].primaryFB.m_cTex.m_iTarget, m_mMonitorRenderResources[m_RenderData.pMonitor].primaryFB.m_cTex.m_iTexID);
 
     // damage region will be scaled, make a temp
     pixman_region32_t tempDamage;
@@ -524,10 +799,8 @@ CFramebuffer* CHyprOpenGLImpl::blurMainFramebufferWithDamage(float a, wlr_box* p
     pixman_region32_fini(&tempDamage);
     pixman_region32_fini(&damage);
 
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
-
-    glBindTexture(PMIRRORFB->m_cTex.m_iTarget, 0);
+    m_sGLState.setCapability(GL_BLEND, true);
+    m_sGLState.blendFunc(GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
 
     return currentRenderToFB;
 }
@@ -535,11 +808,15 @@ CFramebuffer* CHyprOpenGLImpl::blurMainFramebufferWithDamage(float a, wlr_box* p
 void CHyprOpenGLImpl::renderTextureWithBlur(const CTexture& tex, wlr_box* pBox, float a, wlr_surface* pSurface, int round, bool border) {
     RASSERT(m_RenderData.pMonitor, "Tried to render texture with blur without begin()!");
 
+    flushRectBatch();
+
     if (g_pConfigManager->getInt("decoration:blur") == 0) {
         renderTexture(tex, pBox, a, round, false, border);
         return;
     }
 
+    m_mMonitorRenderResources[m_RenderData.pMonitor].lastBlurUse = std::chrono::steady_clock::now();
+
     // make a damage region for this window
     pixman_region32_t damage;
     pixman_region32_init(&damage);
@@ -558,11 +835,15 @@ void CHyprOpenGLImpl::renderTextureWithBlur(const CTexture& tex, wlr_box* pBox,
         pixman_region32_copy(&inverseOpaque, &damage);
     }
 
-    if (!pixman_region32_not_empty(&damage))
+    if (!pixman_region32_not_empty(&damage)) {
+        pixman_region32_fini(&inverseOpaque);
+        pixman_region32_fini(&damage);
         return; // if its empty, reject.
+    }
 
-    // blur the main FB, it will be rendered onto the mirror
-    const auto POUTFB = blurMainFramebufferWithDamage(a, pBox, &inverseOpaque);
+    // if we only have the background below us, use the cached blur.
+    // otherwise blur the main FB, it will be rendered onto the mirror
+    const auto POUTFB = shouldUseCachedBlur() ? &m_mMonitorRenderResources[m_RenderData.pMonitor].blurFB : blurMainFramebufferWithDamage(a, pBox, &inverseOpaque);
 
     pixman_region32_fini(&inverseOpaque);
 
@@ -574,7 +855,7 @@ void CHyprOpenGLImpl::renderTextureWithBlur(const CTexture& tex, wlr_box* pBox,
     glClearStencil(0);
     glClear(GL_STENCIL_BUFFER_BIT);
 
-    glEnable(GL_STENCIL_TEST);
+    m_sGLState.setCapability(GL_STENCIL_TEST, true);
 
     glStencilFunc(GL_ALWAYS, 1, -1);
     glStencilOp(GL_KEEP, GL_KEEP, GL_REPLACE);
@@ -617,11 +898,191 @@ void CHyprOpenGLImpl::renderTextureWithBlur(const CTexture& tex, wlr_box* pBox,
         renderBorder(pBox, BORDERCOL, g_pConfigManager->getInt("general:border_size"), round);
     }
     
-    glDisable(GL_STENCIL_TEST);
+    m_sGLState.setCapability(GL_STENCIL_TEST, false);
     pixman_region32_fini(&damage);
     scissor((wlr_box*)nullptr);
 }
 
+bool CHyprOpenGLImpl::shouldUseCachedBlur() {
+    if (g_pConfigManager->getInt("decoration:blur_new_optimizations") == 0)
+        return false;
+
+    // the cache only has the background and bottom layers, so only tiled windows
+    // (which don't overlap other windows) can use it
+    if (!m_pCurrentWindow || m_pCurrentWindow->m_bIsFloating || m_pCurrentWindow->m_iWorkspaceID == SPECIAL_WORKSPACE_ID)
+        return false;
+
+    const auto PMONITORDATA = &m_mMonitorRenderResources[m_RenderData.pMonitor];
+
+    return !PMONITORDATA->blurFBDirty && PMONITORDATA->blurFB.m_cTex.m_iTexID;
+}
+
+void CHyprOpenGLImpl::markBlurDirtyForMonitor(SMonitor* pMonitor) {
+    const auto IT = m_mMonitorRenderResources.find(pMonitor);
+
+    if (IT == m_mMonitorRenderResources.end())
+        return; // will be dirty when created anyways
+
+    IT->second.blurFBDirty = true;
+}
+
+bool CHyprOpenGLImpl::canReusePrimaryFB(SMonitor* pMonitor) {
+    const auto IT = m_mMonitorRenderResources.find(pMonitor);
+
+    // begin() would reallocate it otherwise
+    return IT != m_mMonitorRenderResources.end() && IT->second.primaryFB.m_cTex.m_iTexID && IT->second.primaryFB.m_Size == pMonitor->vecPixelSize &&
+        IT->second.primaryFBInvalid.width <= 0;
+}
+
+void CHyprOpenGLImpl::invalidatePrimaryFB(SMonitor* pMonitor, const wlr_box& box) {
+    const auto PINVALID = &m_mMonitorRenderResources[pMonitor].primaryFBInvalid;
+
+    // transformed monitors got cleared entirely, see the snapshots
+    const wlr_box NEWBOX = pMonitor->transform == WL_OUTPUT_TRANSFORM_NORMAL ? box : wlr_box{0, 0, (int)pMonitor->vecTransformedSize.x, (int)pMonitor->vecTransformedSize.y};
+
+    // not output damage, the screen (and whoever's capturing it) didn't change.
+    // The next frame redraws it, whenever that comes
+    if (PINVALID->width <= 0 || PINVALID->height <= 0) {
+        *PINVALID = NEWBOX;
+        return;
+    }
+
+    const int X2 = std::max(PINVALID->x + PINVALID->width, NEWBOX.x + NEWBOX.width);
+    const int Y2 = std::max(PINVALID->y + PINVALID->height, NEWBOX.y + NEWBOX.height);
+    PINVALID->x = std::min(PINVALID->x, NEWBOX.x);
+    PINVALID->y = std::min(PINVALID->y, NEWBOX.y);
+    PINVALID->width = X2 - PINVALID->x;
+    PINVALID->height = Y2 - PINVALID->y;
+}
+
+void CHyprOpenGLImpl::repairPrimaryFB(SMonitor* pMonitor, pixman_region32_t* pDamage) {
+    const auto PINVALID = &m_mMonitorRenderResources[pMonitor].primaryFBInvalid;
+
+    if (PINVALID->width <= 0 || PINVALID->height <= 0)
+        return;
+
+    pixman_region32_union_rect(pDamage, pDamage, PINVALID->x, PINVALID->y, PINVALID->width, PINVALID->height);
+    *PINVALID = {0, 0, 0, 0};
+}
+
+bool CHyprOpenGLImpl::preBlurQueued(SMonitor* pMonitor) {
+    if (g_pConfigManager->getInt("decoration:blur") == 0 || g_pConfigManager->getInt("decoration:blur_new_optimizations") == 0)
+        return false;
+
+    // nothing will be visible below a fullscreen window
+    const auto PWORKSPACE = g_pCompositor->getWorkspaceByID(pMonitor->activeWorkspace);
+    if (PWORKSPACE && PWORKSPACE->m_bHasFullscreenWindow)
+        return false;
+
+    const auto IT = m_mMonitorRenderResources.find(pMonitor);
+
+    if (IT == m_mMonitorRenderResources.end())
+        return true;
+
+    // nothing was blurred here for a while (that's why it got released), don't make it just to throw it away again.
+    // The first blurred window will do a full blur and we come back on the next frame
+    const auto TIMEOUT = g_pConfigManager->getInt("decoration:blur_release_timeout");
+    if (!IT->second.blurFB.m_cTex.m_iTexID && TIMEOUT > 0 && std::chrono::steady_clock::now() - IT->second.lastBlurUse >= std::chrono::seconds(TIMEOUT))
+        return false;
+
+    return IT->second.blurFBDirty || IT->second.blurFBSize != g_pConfigManager->getInt("decoration:blur_size") || IT->second.blurFBPasses != g_pConfigManager->getInt("decoration:blur_passes");
+}
+
+void CHyprOpenGLImpl::preWindowPass() {
+    RASSERT(m_RenderData.pMonitor, "Tried to preWindowPass without begin()!");
+
+    if (!preBlurQueued(m_RenderData.pMonitor))
+        return;
+
+    preBlurForCurrentMonitor();
+}
+
+void CHyprOpenGLImpl::preBlurForCurrentMonitor() {
+    // the frame has damaged the entire monitor (see listener_monitorFrame)
+    // so the primary FB has just the background and bottom layers in it now.
+    const auto PMONITORDATA = &m_mMonitorRenderResources[m_RenderData.pMonitor];
+
+    wlr_box monbox = {0, 0, m_RenderData.pMonitor->vecTransformedSize.x, m_RenderData.pMonitor->vecTransformedSize.y};
+
+    pixman_region32_t fakeDamage;
+    pixman_region32_init_rect(&fakeDamage, 0, 0, monbox.width, monbox.height);
+
+    const auto POUTFB = blurMainFramebufferWithDamage(255.f, &monbox, &fakeDamage);
+
+    if (!PMONITORDATA->blurFB.m_cTex.m_iTexID) {
+        PMONITORDATA->blurFB.m_sOwner = {GPU_OWNER_MONITOR, m_RenderData.pMonitor, "blur cache"};
+        PMONITORDATA->blurFB.alloc(m_RenderData.pMonitor->vecPixelSize.x, m_RenderData.pMonitor->vecPixelSize.y);
+    }
+
+    // copy the result over, the mirrors get reused by the other blurs
+    const auto PREVDAMAGE = m_RenderData.pDamage;
+    m_RenderData.pDamage = &fakeDamage;
+
+    PMONITORDATA->blurFB.bind();
+    clear(CColor(0, 0, 0, 0));
+    renderTextureInternalWithDamage(POUTFB->m_cTex, &monbox, 255.f, &fakeDamage, 0);
+
+    m_RenderData.pDamage = PREVDAMAGE;
+
+    pixman_region32_fini(&fakeDamage);
+
+    PMONITORDATA->primaryFB.bind();
+    scissor((wlr_box*)nullptr);
+
+    PMONITORDATA->blurFBDirty = false;
+    PMONITORDATA->blurFBSize = g_pConfigManager->getInt("decoration:blur_size");
+    PMONITORDATA->blurFBPasses = g_pConfigManager->getInt("decoration:blur_passes");
+}
+
+void CHyprOpenGLImpl::flushRectBatch() {
+    if (m_vRectBatch.empty())
+        return;
+
+    const auto VERTS = m_vRectBatch.size() / 6;
+
+    m_sGLState.setCapability(GL_BLEND, true);
+    m_sGLState.blendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+    m_sGLState.useProgram(m_shQUADBATCH.program);
+
+#ifndef GLES2
+    m_sGLState.bindVertexArray(m_shQUADBATCH.vao);
+#endif
+    m_sGLState.bindArrayBuffer(m_iRectBatchVBO);
+    glBufferData(GL_ARRAY_BUFFER, m_vRectBatch.size() * sizeof(float), m_vRectBatch.data(), GL_STREAM_DRAW);
+#ifdef GLES2
+    glVertexAttribPointer(m_shQUADBATCH.posAttrib, 2, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)0);
+    glVertexAttribPointer(m_shQUADBATCH.colorAttrib, 4, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)(2 * sizeof(float)));
+    m_sGLState.setVertexAttribArrays(m_shQUADBATCH.posAttrib, m_shQUADBATCH.colorAttrib);
+#endif
+
+    // one draw per damage rect for all of them
+    if (pixman_region32_not_empty(m_RenderData.pDamage)) {
+        PIXMAN_DAMAGE_FOREACH(m_RenderData.pDamage) {
+            const auto RECT = RECTSARR[i];
+            scissor(&RECT);
+            m_sGLState.drawArrays(GL_TRIANGLES, 0, VERTS);
+        }
+    }
+
+    m_vRectBatch.clear();
+
+    m_sGLState.blendFunc(GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+}
+
+void CHyprOpenGLImpl::releaseStateForWLR() {
+    flushRectBatch();
+
+    // wlr uses client-side arrays, so no VAO or buffer can stay bound
+#ifndef GLES2
+    m_sGLState.bindVertexArray(0);
+#else
+    m_sGLState.disableAllVertexAttribArrays();
+#endif
+    m_sGLState.bindArrayBuffer(0);
+    m_sGLState.bindTexture(GL_TEXTURE_2D, 0);
+}
+
 void pushVert2D(float x, float y, float* arr, int& counter, wlr_box* box) {
     // 0-1 space god damnit
     arr[counter * 2 + 0] = x / box->width;
@@ -648,17 +1109,83 @@ void CHyprOpenGLImpl::renderBorder(wlr_box* box, const CColor& col, int thick, i
     renderRect(box, col, round);
 }
 
+static void unionSurfaceBox(wlr_surface* surface, int x, int y, void* data) {
+    const auto PBOX = (wlr_box*)data;
+
+    const int X2 = std::max(PBOX->x + PBOX->width, x + surface->current.width);
+    const int Y2 = std::max(PBOX->y + PBOX->height, y + surface->current.height);
+
+    PBOX->x = std::min(PBOX->x, x);
+    PBOX->y = std::min(PBOX->y, y);
+    PBOX->width = X2 - PBOX->x;
+    PBOX->height = Y2 - PBOX->y;
+}
+
+void CHyprOpenGLImpl::copyToSnapshot(SSnapshot* pSnapshot, SMonitor* pMonitor) {
+    // whatever's outside of the box in the pooled fb is leftovers from a previous user
+    glBindFramebuffer(GL_FRAMEBUFFER, pSnapshot->pFramebuffer->m_iFb);
+    scissor((wlr_box*)nullptr);
+    glClearColor(0, 0, 0, 0);
+    glClear(GL_COLOR_BUFFER_BIT);
+
+    // copy straight from the primary fb, no need to draw anything
+    glBindFramebuffer(GL_FRAMEBUFFER, m_mMonitorRenderResources[pMonitor].primaryFB.m_iFb);
+    m_sGLState.bindTexture(GL_TEXTURE_2D, pSnapshot->pFramebuffer->m_cTex.m_iTexID);
+    glCopyTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, pSnapshot->box.x, pSnapshot->box.y, pSnapshot->box.width, pSnapshot->box.height);
+    m_sGLState.bindTexture(GL_TEXTURE_2D, 0);
+
+    // restore original fb
+    glBindFramebuffer(GL_FRAMEBUFFER, m_iCurrentOutputFb);
+}
+
 void CHyprOpenGLImpl::makeWindowSnapshot(CWindow* pWindow) {
     // we trust the window is valid.
     const auto PMONITOR = g_pCompositor->getMonitorFromID(pWindow->m_iMonitorID);
+    const auto PWORKSPACE = g_pCompositor->getWorkspaceByID(pWindow->m_iWorkspaceID);
+    const auto BORDERSIZE = g_pConfigManager->getInt("general:border_size");
+
+    const auto SNAPSHOTBEGIN = std::chrono::high_resolution_clock::now();
+
+    // we only need the window itself, with its decorations, border and popups
+    wlr_box windowBox = pWindow->getFullWindowBoundingBox();
+    windowBox.x -= BORDERSIZE;
+    windowBox.y -= BORDERSIZE;
+    windowBox.width += 2 * BORDERSIZE;
+    windowBox.height += 2 * BORDERSIZE;
+
+    if (!pWindow->m_bIsX11) {
+        wlr_box popupBox = {windowBox.x - (int)pWindow->m_vRealPosition.vec().x, windowBox.y - (int)pWindow->m_vRealPosition.vec().y, windowBox.width, windowBox.height};
+        wlr_xdg_surface_for_each_popup_surface(pWindow->m_uSurface.xdg, unionSurfaceBox, &popupBox);
+        windowBox = {popupBox.x + (int)pWindow->m_vRealPosition.vec().x, popupBox.y + (int)pWindow->m_vRealPosition.vec().y, popupBox.width, popupBox.height};
+    }
+
+    windowBox.x -= PMONITOR->vecPosition.x - (PWORKSPACE ? PWORKSPACE->m_vRenderOffset.vec().x : 0);
+    windowBox.y -= PMONITOR->vecPosition.y - (PWORKSPACE ? PWORKSPACE->m_vRenderOffset.vec().y : 0);
+    scaleBox(&windowBox, PMONITOR->scale);
+
+    wlr_box monitorBox = {0, 0, PMONITOR->vecPixelSize.x, PMONITOR->vecPixelSize.y};
+    wlr_box snapshotBox;
+    if (!wlr_box_intersection(&snapshotBox, &windowBox, &monitorBox)) {
+        Debug::log(LOG, "Window %x is not on its monitor, not making a snapshot", pWindow);
+        return;
+    }
+
+    // the primary FB is in output space, the box isn't, so take all of it like the workspace snapshots do
+    if (PMONITOR->transform != WL_OUTPUT_TRANSFORM_NORMAL)
+        snapshotBox = monitorBox;
+
     wlr_output_attach_render(PMONITOR->output, nullptr);
 
-    // we need to "damage" the entire monitor
+    // we need to "damage" the window box
     // so that we render the entire window
     // this is temporary, doesnt mess with the actual wlr damage
+    // (scissoring goes through the output transform, so transformed monitors get everything)
     pixman_region32_t fakeDamage;
     pixman_region32_init(&fakeDamage);
-    pixman_region32_union_rect(&fakeDamage, &fakeDamage, 0, 0, (int)PMONITOR->vecPixelSize.x, (int)PMONITOR->vecPixelSize.y);
+    if (PMONITOR->transform == WL_OUTPUT_TRANSFORM_NORMAL)
+        pixman_region32_union_rect(&fakeDamage, &fakeDamage, snapshotBox.x, snapshotBox.y, snapshotBox.width, snapshotBox.height);
+    else
+        pixman_region32_union_rect(&fakeDamage, &fakeDamage, 0, 0, (int)PMONITOR->vecPixelSize.x, (int)PMONITOR->vecPixelSize.y);
 
     begin(PMONITOR, &fakeDamage, true);
 
@@ -681,57 +1208,72 @@ void CHyprOpenGLImpl::makeWindowSnapshot(CWindow* pWindow) {
 
     g_pConfigManager->setInt("decoration:blur", BLURVAL);
 
-    // render onto the window fb
-    // we rendered onto the primary because it has a stencil, which we need for the borders etc
-    const auto PFRAMEBUFFER = &m_mWindowFramebuffers[pWindow];
-
-    glViewport(0, 0, g_pHyprOpenGL->m_RenderData.pMonitor->vecPixelSize.x, g_pHyprOpenGL->m_RenderData.pMonitor->vecPixelSize.y);
+    flushRectBatch();
 
-    PFRAMEBUFFER->alloc(PMONITOR->vecPixelSize.x, PMONITOR->vecPixelSize.y);
-
-    PFRAMEBUFFER->bind();
-
-    clear(CColor(0, 0, 0, 0));  // JIC
+    // we rendered onto the primary because it has a stencil, which we need for the borders etc
+    // now crop it into a pooled fb
+    releaseSnapshot(pWindow);
 
-    wlr_box fullMonBox = {0, 0, PMONITOR->vecPixelSize.x, PMONITOR->vecPixelSize.y};
-    renderTexture(m_mMonitorRenderResources[m_RenderData.pMonitor].primaryFB.m_cTex, &fullMonBox, 255.f, 0);
+    const auto PSNAPSHOT = &m_mWindowFramebuffers[pWindow];
+    PSNAPSHOT->box = snapshotBox;
+    PSNAPSHOT->pFramebuffer = m_sSnapshotPool.get(snapshotBox.width, snapshotBox.height);
+    PSNAPSHOT->pFramebuffer->setOwner({GPU_OWNER_WINDOW, pWindow, "snapshot"});
 
-    // restore original fb
-    #ifndef GLES2
-    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, m_iCurrentOutputFb);
-    #else
-    glBindFramebuffer(GL_FRAMEBUFFER, m_iCurrentOutputFb);
-    #endif
+    copyToSnapshot(PSNAPSHOT, PMONITOR);
 
     end();
 
     wlr_output_rollback(PMONITOR->output);
+
+    // we drew over the last frame in the primary FB, cursor-only frames can't copy from it there
+    invalidatePrimaryFB(PMONITOR, snapshotBox);
+
+    const float SNAPSHOTMS = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::high_resolution_clock::now() - SNAPSHOTBEGIN).count() / 1000.f;
+    Debug::log(LOG, "Window snapshot %ix%i (fb %ix%i) took %.2fms, pool: %i KiB allocated, %i KiB in use", snapshotBox.width, snapshotBox.height, (int)PSNAPSHOT->pFramebuffer->m_Size.x,
+               (int)PSNAPSHOT->pFramebuffer->m_Size.y, SNAPSHOTMS, (int)(m_sSnapshotPool.m_iBytesAllocated / 1024), (int)(m_sSnapshotPool.m_iBytesInUse / 1024));
 }
 
 void CHyprOpenGLImpl::makeLayerSnapshot(SLayerSurface* pLayer) {
     // we trust the window is valid.
     const auto PMONITOR = g_pCompositor->getMonitorFromID(pLayer->monitorID);
+
+    // same box the renderer will draw the layer at, plus subsurfaces
+    double outputX = 0, outputY = 0;
+    wlr_output_layout_output_coords(g_pCompositor->m_sWLROutputLayout, PMONITOR->output, &outputX, &outputY);
+
+    wlr_box layerBox;
+    wlr_surface_get_extends(pLayer->layerSurface->surface, &layerBox);
+    layerBox.x += (int)outputX + pLayer->geometry.x;
+    layerBox.y += (int)outputY + pLayer->geometry.y;
+    scaleBox(&layerBox, PMONITOR->scale);
+
+    wlr_box monitorBox = {0, 0, PMONITOR->vecPixelSize.x, PMONITOR->vecPixelSize.y};
+    wlr_box snapshotBox;
+    if (!wlr_box_intersection(&snapshotBox, &layerBox, &monitorBox)) {
+        Debug::log(LOG, "Layer %x is not on its monitor, not making a snapshot", pLayer);
+        return;
+    }
+
+    // the primary FB is in output space, the box isn't, so take all of it like the workspace snapshots do
+    if (PMONITOR->transform != WL_OUTPUT_TRANSFORM_NORMAL)
+        snapshotBox = monitorBox;
+
     wlr_output_attach_render(PMONITOR->output, nullptr);
 
-    // we need to "damage" the entire monitor
-    // so that we render the entire window
+    // we need to "damage" the layer box
+    // so that we render the entire layer
     // this is temporary, doesnt mess with the actual wlr damage
     pixman_region32_t fakeDamage;
     pixman_region32_init(&fakeDamage);
-    pixman_region32_union_rect(&fakeDamage, &fakeDamage, 0, 0, (int)PMONITOR->vecPixelSize.x, (int)PMONITOR->vecPixelSize.y);
+    if (PMONITOR->transform == WL_OUTPUT_TRANSFORM_NORMAL)
+        pixman_region32_union_rect(&fakeDamage, &fakeDamage, snapshotBox.x, snapshotBox.y, snapshotBox.width, snapshotBox.height);
+    else
+        pixman_region32_union_rect(&fakeDamage, &fakeDamage, 0, 0, (int)PMONITOR->vecPixelSize.x, (int)PMONITOR->vecPixelSize.y);
 
     begin(PMONITOR, &fakeDamage, true);
 
     pixman_region32_fini(&fakeDamage);
 
-    const auto PFRAMEBUFFER = &m_mLayerFramebuffers[pLayer];
-
-    glViewport(0, 0, g_pHyprOpenGL->m_RenderData.pMonitor->vecPixelSize.x, g_pHyprOpenGL->m_RenderData.pMonitor->vecPixelSize.y);
-
-    PFRAMEBUFFER->alloc(PMONITOR->vecPixelSize.x, PMONITOR->vecPixelSize.y);
-
-    PFRAMEBUFFER->bind();
-
     clear(CColor(0, 0, 0, 0));  // JIC
 
     timespec now;
@@ -740,50 +1282,103 @@ void CHyprOpenGLImpl::makeLayerSnapshot(SLayerSurface* pLayer) {
     // draw the layer
     g_pHyprRenderer->renderLayer(pLayer, PMONITOR, &now);
 
+    flushRectBatch();
+
     // TODO: WARN:
     // revise if any stencil-requiring rendering is done to the layers.
 
-// restore original fb
-#ifndef GLES2
-    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, m_iCurrentOutputFb);
-#else
-    glBindFramebuffer(GL_FRAMEBUFFER, m_iCurrentOutputFb);
-#endif
+    releaseSnapshot(pLayer);
+
+    const auto PSNAPSHOT = &m_mLayerFramebuffers[pLayer];
+    PSNAPSHOT->box = snapshotBox;
+    PSNAPSHOT->pFramebuffer = m_sSnapshotPool.get(snapshotBox.width, snapshotBox.height);
+    PSNAPSHOT->pFramebuffer->setOwner({GPU_OWNER_LAYER, pLayer, "snapshot"});
+
+    copyToSnapshot(PSNAPSHOT, PMONITOR);
 
     end();
 
     wlr_output_rollback(PMONITOR->output);
+
+    // we drew over the last frame in the primary FB, cursor-only frames can't copy from it there
+    invalidatePrimaryFB(PMONITOR, snapshotBox);
+}
+
+void CHyprOpenGLImpl::makeWorkspaceSnapshot(CWorkspace* pWorkspace, SMonitor* pMonitor) {
+    const auto SNAPSHOTBEGIN = std::chrono::high_resolution_clock::now();
+
+    const wlr_box MONITORBOX = {0, 0, pMonitor->vecPixelSize.x, pMonitor->vecPixelSize.y};
+
+    wlr_output_attach_render(pMonitor->output, nullptr);
+
+    pixman_region32_t fakeDamage;
+    pixman_region32_init_rect(&fakeDamage, 0, 0, (int)pMonitor->vecPixelSize.x, (int)pMonitor->vecPixelSize.y);
+
+    begin(pMonitor, &fakeDamage, true);
+
+    pixman_region32_fini(&fakeDamage);
+
+    clear(CColor(0, 0, 0, 0));
+
+    timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    // same as the window snapshots, there's nothing behind the windows here to blur
+    const auto BLURVAL = g_pConfigManager->getInt("decoration:blur");
+    g_pConfigManager->setInt("decoration:blur", 0);
+
+    g_pHyprRenderer->renderWorkspaceWindows(pWorkspace, pMonitor, &now);
+
+    g_pConfigManager->setInt("decoration:blur", BLURVAL);
+
+    flushRectBatch();
+
+    releaseSnapshot(pWorkspace);
+
+    const auto PSNAPSHOT = &m_mWorkspaceFramebuffers[pWorkspace];
+    PSNAPSHOT->box = MONITORBOX;
+    PSNAPSHOT->pFramebuffer = m_sSnapshotPool.get(MONITORBOX.width, MONITORBOX.height);
+    PSNAPSHOT->pFramebuffer->setOwner({GPU_OWNER_WORKSPACE, pWorkspace, "snapshot"});
+    PSNAPSHOT->captured = std::chrono::steady_clock::now();
+
+    copyToSnapshot(PSNAPSHOT, pMonitor);
+
+    end();
+
+    wlr_output_rollback(pMonitor->output);
+
+    invalidatePrimaryFB(pMonitor, MONITORBOX);
+
+    const float SNAPSHOTMS = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::high_resolution_clock::now() - SNAPSHOTBEGIN).count() / 1000.f;
+    Debug::log(LOG, "Workspace %s snapshot took %.2fms", pWorkspace->m_szName.c_str(), SNAPSHOTMS);
 }
 
 void CHyprOpenGLImpl::renderSnapshot(CWindow** pWindow) {
     RASSERT(m_RenderData.pMonitor, "Tried to render snapshot rect without begin()!");
     const auto PWINDOW = *pWindow;
 
-    auto it = m_mWindowFramebuffers.begin();
-    for (; it != m_mWindowFramebuffers.end(); it++) {
-        if (it->first == PWINDOW) {
-            break;
-        }
-    }
+    const auto IT = m_mWindowFramebuffers.find(PWINDOW);
 
-    if (it == m_mWindowFramebuffers.end() || !it->second.m_cTex.m_iTexID)
+    if (IT == m_mWindowFramebuffers.end() || !IT->second.pFramebuffer || !IT->second.pFramebuffer->m_cTex.m_iTexID)
         return;
 
     const auto PMONITOR = g_pCompositor->getMonitorFromID(PWINDOW->m_iMonitorID);
+    const auto PSNAPSHOT = &IT->second;
 
     wlr_box windowBox;
     // some mafs to figure out the correct box
     Vector2D scaleXY = Vector2D((PWINDOW->m_vRealSize.vec().x / PWINDOW->m_vOriginalClosedSize.x), (PWINDOW->m_vRealSize.vec().y / PWINDOW->m_vOriginalClosedSize.y));
 
-    windowBox.width = PMONITOR->vecPixelSize.x * scaleXY.x;
-    windowBox.height = PMONITOR->vecPixelSize.y * scaleXY.y;
-    windowBox.x = (PWINDOW->m_vRealPosition.vec().x - PMONITOR->vecPosition.x) - ((PWINDOW->m_vOriginalClosedPos.x - PMONITOR->vecPosition.x) * scaleXY.x);
-    windowBox.y = (PWINDOW->m_vRealPosition.vec().y - PMONITOR->vecPosition.y) - ((PWINDOW->m_vOriginalClosedPos.y - PMONITOR->vecPosition.y) * scaleXY.y);
+    // the whole fb is drawn, the part past the snapshot box is transparent
+    windowBox.width = PSNAPSHOT->pFramebuffer->m_Size.x * scaleXY.x;
+    windowBox.height = PSNAPSHOT->pFramebuffer->m_Size.y * scaleXY.y;
+    windowBox.x = (PWINDOW->m_vRealPosition.vec().x - PMONITOR->vecPosition.x) - ((PWINDOW->m_vOriginalClosedPos.x - PMONITOR->vecPosition.x) * scaleXY.x) + PSNAPSHOT->box.x * scaleXY.x;
+    windowBox.y = (PWINDOW->m_vRealPosition.vec().y - PMONITOR->vecPosition.y) - ((PWINDOW->m_vOriginalClosedPos.y - PMONITOR->vecPosition.y) * scaleXY.y) + PSNAPSHOT->box.y * scaleXY.y;
 
     pixman_region32_t fakeDamage;
     pixman_region32_init_rect(&fakeDamage, 0, 0, PMONITOR->vecPixelSize.x, PMONITOR->vecPixelSize.y);
 
-    renderTextureInternalWithDamage(it->second.m_cTex, &windowBox, PWINDOW->m_fAlpha.fl(), &fakeDamage, 0);
+    renderTextureInternalWithDamage(PSNAPSHOT->pFramebuffer->m_cTex, &windowBox, PWINDOW->m_fAlpha.fl(), &fakeDamage, 0);
 
     pixman_region32_fini(&fakeDamage);
 }
@@ -792,28 +1387,145 @@ void CHyprOpenGLImpl::renderSnapshot(SLayerSurface** pLayer) {
     RASSERT(m_RenderData.pMonitor, "Tried to render snapshot rect without begin()!");
     const auto PLAYER = *pLayer;
 
-    auto it = m_mLayerFramebuffers.begin();
-    for (; it != m_mLayerFramebuffers.end(); it++) {
-        if (it->first == PLAYER) {
-            break;
-        }
-    }
+    const auto IT = m_mLayerFramebuffers.find(PLAYER);
 
-    if (it == m_mLayerFramebuffers.end() || !it->second.m_cTex.m_iTexID)
+    if (IT == m_mLayerFramebuffers.end() || !IT->second.pFramebuffer || !IT->second.pFramebuffer->m_cTex.m_iTexID)
         return;
 
     const auto PMONITOR = g_pCompositor->getMonitorFromID(PLAYER->monitorID);
+    const auto PSNAPSHOT = &IT->second;
 
-    wlr_box windowBox = {0, 0, PMONITOR->vecPixelSize.x, PMONITOR->vecPixelSize.y};
+    wlr_box windowBox = {PSNAPSHOT->box.x, PSNAPSHOT->box.y, PSNAPSHOT->pFramebuffer->m_Size.x, PSNAPSHOT->pFramebuffer->m_Size.y};
 
     pixman_region32_t fakeDamage;
     pixman_region32_init_rect(&fakeDamage, 0, 0, PMONITOR->vecPixelSize.x, PMONITOR->vecPixelSize.y);
 
-    renderTextureInternalWithDamage(it->second.m_cTex, &windowBox, PLAYER->alpha.fl(), &fakeDamage, 0);
+    renderTextureInternalWithDamage(PSNAPSHOT->pFramebuffer->m_cTex, &windowBox, PLAYER->alpha.fl(), &fakeDamage, 0);
 
     pixman_region32_fini(&fakeDamage);
 }
 
+void CHyprOpenGLImpl::renderSnapshot(CWorkspace* pWorkspace) {
+    RASSERT(m_RenderData.pMonitor, "Tried to render snapshot rect without begin()!");
+
+    const auto IT = m_mWorkspaceFramebuffers.find(pWorkspace);
+
+    if (IT == m_mWorkspaceFramebuffers.end() || !IT->second.pFramebuffer || !IT->second.pFramebuffer->m_cTex.m_iTexID)
+        return;
+
+    const auto PSNAPSHOT = &IT->second;
+    const auto OFFSET = pWorkspace->m_vRenderOffset.vec() * m_RenderData.pMonitor->scale;
+
+    // the whole thing moves, so a single quad instead of all the windows
+    wlr_box workspaceBox = {(int)OFFSET.x, (int)OFFSET.y, PSNAPSHOT->pFramebuffer->m_Size.x, PSNAPSHOT->pFramebuffer->m_Size.y};
+
+    renderTextureInternalWithDamage(PSNAPSHOT->pFramebuffer->m_cTex, &workspaceBox, pWorkspace->m_fAlpha.fl(), m_RenderData.pDamage, 0);
+}
+
+void CHyprOpenGLImpl::releaseSnapshot(CWindow* pWindow) {
+    const auto IT = m_mWindowFramebuffers.find(pWindow);
+
+    if (IT == m_mWindowFramebuffers.end())
+        return;
+
+    m_sSnapshotPool.put(IT->second.pFramebuffer);
+    m_mWindowFramebuffers.erase(IT);
+}
+
+void CHyprOpenGLImpl::releaseSnapshot(SLayerSurface* pLayer) {
+    const auto IT = m_mLayerFramebuffers.find(pLayer);
+
+    if (IT == m_mLayerFramebuffers.end())
+        return;
+
+    m_sSnapshotPool.put(IT->second.pFramebuffer);
+    m_mLayerFramebuffers.erase(IT);
+}
+
+void CHyprOpenGLImpl::releaseSnapshot(CWorkspace* pWorkspace) {
+    const auto IT = m_mWorkspaceFramebuffers.find(pWorkspace);
+
+    if (IT == m_mWorkspaceFramebuffers.end())
+        return;
+
+    m_sSnapshotPool.put(IT->second.pFramebuffer);
+    m_mWorkspaceFramebuffers.erase(IT);
+}
+
+void CHyprOpenGLImpl::renderWorkspaceThumbnail(CWorkspace* pWorkspace, CFramebuffer* pFramebuffer, const Vector2D& size) {
+    RASSERT(m_RenderData.pMonitor, "Tried to render a thumbnail without begin()!");
+
+    const auto PMONITOR = m_RenderData.pMonitor;
+    const auto PMONITORDATA = &m_mMonitorRenderResources[PMONITOR];
+    wlr_box monbox = {0, 0, PMONITOR->vecPixelSize.x, PMONITOR->vecPixelSize.y};
+
+    timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    // full size into the primary fb first, like a frame with just the wallpaper and this workspace
+    PMONITORDATA->primaryFB.bind();
+    clear(CColor(0, 0, 0, 255));
+
+    // blur wouldn't be visible at thumbnail size anyway
+    const auto BLURVAL = g_pConfigManager->getInt("decoration:blur");
+    g_pConfigManager->setInt("decoration:blur", 0);
+
+    for (auto& ls : PMONITOR->m_aLayerSurfaceLists[ZWLR_LAYER_SHELL_V1_LAYER_BACKGROUND])
+        g_pHyprRenderer->renderLayer(ls, PMONITOR, &now);
+    for (auto& ls : PMONITOR->m_aLayerSurfaceLists[ZWLR_LAYER_SHELL_V1_LAYER_BOTTOM])
+        g_pHyprRenderer->renderLayer(ls, PMONITOR, &now);
+
+    g_pHyprRenderer->renderWorkspaceWindows(pWorkspace, PMONITOR, &now);
+
+    g_pConfigManager->setInt("decoration:blur", BLURVAL);
+
+    // then scale it down. The projection stays the monitor's, so the monitor box fills the smaller viewport
+    if (!pFramebuffer->m_cTex.m_iTexID)
+        pFramebuffer->m_sOwner = {GPU_OWNER_WORKSPACE, pWorkspace, "thumbnail"};
+    pFramebuffer->alloc(size.x, size.y);
+
+    pFramebuffer->bind();
+    glViewport(0, 0, size.x, size.y);
+    clear(CColor(0, 0, 0, 255));
+
+    renderTexture(PMONITORDATA->primaryFB.m_cTex, &monbox, 255.f, 0);
+
+    // back to the frame, with its viewport. bind() would set it too, the frame shouldn't rely on that
+    PMONITORDATA->primaryFB.bind();
+    glViewport(0, 0, PMONITOR->vecPixelSize.x, PMONITOR->vecPixelSize.y);
+}
+
+bool CHyprOpenGLImpl::readFramebuffer(CFramebuffer* pFramebuffer, void* pData) {
+    RASSERT(m_RenderData.pMonitor, "Tried to read a framebuffer without begin()!");
+
+    if (!pFramebuffer->m_cTex.m_iTexID)
+        return false;
+
+    flushRectBatch();
+
+    const int W = pFramebuffer->m_Size.x;
+    const int H = pFramebuffer->m_Size.y;
+
+    // our fbs are top row first already, see the flip in renderTextureInternalWithDamage
+    glBindFramebuffer(GL_FRAMEBUFFER, pFramebuffer->m_iFb);
+    glPixelStorei(GL_PACK_ALIGNMENT, 4);
+
+    // xrgb8888 is bgra in memory, most drivers can give us that directly
+    if (m_bReadBGRA) {
+        glReadPixels(0, 0, W, H, GL_BGRA_EXT, GL_UNSIGNED_BYTE, pData);
+    } else {
+        glReadPixels(0, 0, W, H, GL_RGBA, GL_UNSIGNED_BYTE, pData);
+
+        const auto PIXELS = (uint8_t*)pData;
+        for (size_t i = 0; i < (size_t)W * H * 4; i += 4)
+            std::swap(PIXELS[i], PIXELS[i + 2]);
+    }
+
+    glBindFramebuffer(GL_FRAMEBUFFER, m_iCurrentOutputFb);
+
+    return true;
+}
+
 void CHyprOpenGLImpl::createBGTextureForMonitor(SMonitor* pMonitor) {
     RASSERT(m_RenderData.pMonitor, "Tried to createBGTex without begin()!");
 
@@ -821,7 +1533,7 @@ void CHyprOpenGLImpl::createBGTextureForMonitor(SMonitor* pMonitor) {
     const auto PTEX = &m_mMonitorBGTextures[pMonitor];
     PTEX->destroyTexture();
 
-    PTEX->allocate();
+    PTEX->allocate({GPU_OWNER_MONITOR, pMonitor, "background"});
 
     Debug::log(LOG, "Allocated texture for BGTex");
 
@@ -850,14 +1562,15 @@ void CHyprOpenGLImpl::createBGTextureForMonitor(SMonitor* pMonitor) {
 
     // copy the data to an OpenGL texture we have
     const auto DATA = cairo_image_surface_get_data(CAIROSURFACE);
-    glBindTexture(GL_TEXTURE_2D, PTEX->m_iTexID);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    m_sGLState.bindTexture(GL_TEXTURE_2D, PTEX->m_iTexID);
+    m_sGLState.texParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    m_sGLState.texParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
     #ifndef GLES2
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_R, GL_BLUE);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_B, GL_RED);
+    m_sGLState.texParameteri(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_R, GL_BLUE);
+    m_sGLState.texParameteri(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_B, GL_RED);
     #endif
     glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, textureSize.x, textureSize.y, 0, GL_RGBA, GL_UNSIGNED_BYTE, DATA);
+    m_sGPUResources.setStorage(PTEX->m_iTexID, textureSize, "RGBA8", 4);
 
     cairo_surface_destroy(CAIROSURFACE);
     cairo_destroy(CAIRO);
@@ -873,13 +1586,82 @@ void CHyprOpenGLImpl::clearWithTex() {
     renderTexture(m_mMonitorBGTextures[m_RenderData.pMonitor], &box, 255, 0);
 }
 
+void CHyprOpenGLImpl::allocBlurBuffers() {
+    const auto PMONITORDATA = &m_mMonitorRenderResources[m_RenderData.pMonitor];
+    const auto PIXELSIZE = m_RenderData.pMonitor->vecPixelSize;
+
+    if (PMONITORDATA->mirrorSwapFB.m_cTex.m_iTexID)
+        return;
+
+    // the mirror only ever gets the downsampled passes (every even pass, the first one being half res),
+    // the full res result always ends up in the swap one.
+    // Neither needs a stencil, only the primary FB gets stenciled into.
+    PMONITORDATA->mirrorFB.m_sOwner = {GPU_OWNER_MONITOR, m_RenderData.pMonitor, "blur mirror"};
+    PMONITORDATA->mirrorSwapFB.m_sOwner = {GPU_OWNER_MONITOR, m_RenderData.pMonitor, "blur mirror swap"};
+    PMONITORDATA->mirrorFB.alloc(std::ceil(PIXELSIZE.x / 2.f), std::ceil(PIXELSIZE.y / 2.f));
+    PMONITORDATA->mirrorSwapFB.alloc(PIXELSIZE.x, PIXELSIZE.y);
+
+    g_pCompositor->scheduleHousekeeping(1000); // to free them again if they go unused
+
+    Debug::log(LOG, "Monitor %s: allocated blur buffers", m_RenderData.pMonitor->szName.c_str());
+}
+
+void CHyprOpenGLImpl::releaseBlurBuffers(SMonitorRenderData* pData) {
+    pData->mirrorFB.release();
+    pData->mirrorSwapFB.release();
+    pData->blurFB.release();
+    pData->blurFBDirty = true;
+}
+
+bool CHyprOpenGLImpl::releaseIdleBlurBuffers() {
+    const auto TIMEOUT = g_pConfigManager->getInt("decoration:blur_release_timeout");
+    const auto NOW = std::chrono::steady_clock::now();
+
+    if (TIMEOUT <= 0)
+        return false;
+
+    bool stillAllocated = false;
+    bool contextCurrent = false;
+
+    for (auto& [pMonitor, data] : m_mMonitorRenderResources) {
+        if (!data.mirrorSwapFB.m_cTex.m_iTexID && !data.blurFB.m_cTex.m_iTexID)
+            continue;
+
+        if (NOW - data.lastBlurUse < std::chrono::seconds(TIMEOUT)) {
+            stillAllocated = true;
+            continue;
+        }
+
+        // we are outside of a frame here
+        if (!contextCurrent) {
+            RASSERT(eglMakeCurrent(wlr_egl_get_display(g_pCompositor->m_sWLREGL), EGL_NO_SURFACE, EGL_NO_SURFACE, wlr_egl_get_context(g_pCompositor->m_sWLREGL)), "Couldn't set current EGL!");
+            contextCurrent = true;
+        }
+
+        releaseBlurBuffers(&data);
+
+        Debug::log(LOG, "Monitor %s: released blur buffers after %is without blur", pMonitor->szName.c_str(), TIMEOUT);
+    }
+
+    if (contextCurrent)
+        RASSERT(eglMakeCurrent(wlr_egl_get_display(g_pCompositor->m_sWLREGL), EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT), "Couldn't unset current EGL!");
+
+    return stillAllocated;
+}
+
 void CHyprOpenGLImpl::destroyMonitorResources(SMonitor* pMonitor) {
-    g_pHyprOpenGL->m_mMonitorRenderResources[pMonitor].mirrorFB.release();
+    // called on monitor destroy and on mode changes, both outside of a frame, where wlr doesn't
+    // keep the context current. Without it the glDelete*s do nothing and all of this leaks
+    RASSERT(eglMakeCurrent(wlr_egl_get_display(g_pCompositor->m_sWLREGL), EGL_NO_SURFACE, EGL_NO_SURFACE, wlr_egl_get_context(g_pCompositor->m_sWLREGL)), "Couldn't set current EGL!");
+
+    releaseBlurBuffers(&g_pHyprOpenGL->m_mMonitorRenderResources[pMonitor]);
     g_pHyprOpenGL->m_mMonitorRenderResources[pMonitor].primaryFB.release();
     g_pHyprOpenGL->m_mMonitorRenderResources[pMonitor].stencilTex.destroyTexture();
     g_pHyprOpenGL->m_mMonitorBGTextures[pMonitor].destroyTexture();
     g_pHyprOpenGL->m_mMonitorRenderResources.erase(pMonitor);
     g_pHyprOpenGL->m_mMonitorBGTextures.erase(pMonitor);
 
+    RASSERT(eglMakeCurrent(wlr_egl_get_display(g_pCompositor->m_sWLREGL), EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT), "Couldn't unset current EGL!");
+
     Debug::log(LOG, "Monitor %s -> destroyed all render data", pMonitor->szName.c_str());
 }
@@ -5,11 +5,22 @@
 #include "../helpers/Color.hpp"
 #include <list>
 #include <unordered_map>
+#include <vector>
+#include <chrono>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <atomic>
 
 #include "Shaders.hpp"
 #include "Shader.hpp"
 #include "Texture.hpp"
 #include "Framebuffer.hpp"
+#include "FramebufferPool.hpp"
+#include "GLState.hpp"
+#include "GPUResources.hpp"
+#include "ShaderCache.hpp"
 
 inline const float matrixFlip180[] = {
 	1.0f, 0.0f, 0.0f,
@@ -38,16 +49,52 @@ struct SCurrentRenderData {
 
 struct SMonitorRenderData {
     CFramebuffer primaryFB;
-    CFramebuffer mirrorFB;
+
+    // only allocated while blur is in use, see allocBlurBuffers / releaseIdleBlurBuffers
+    CFramebuffer mirrorFB;      // half res
     CFramebuffer mirrorSwapFB;
+    CFramebuffer blurFB; // cached blur of the background + bottom layers
+    std::chrono::steady_clock::time_point lastBlurUse;
 
     CTexture     stencilTex;
+
+    bool         blurFBDirty = true;
+    int          blurFBSize = -1;   // blur_size and blur_passes the cache was made with
+    int          blurFBPasses = -1;
+
+    // clobbered by a snapshot or thumbnail, redrawn with the next frame. Nothing changed on screen
+    wlr_box      primaryFBInvalid = {0, 0, 0, 0};
+
+    // last frame's GL state calls
+    int          glCallsIssued = 0;
+    int          glCallsElided = 0;
+    int          glDrawCalls = 0;
+};
+
+// a closing window's / layer's last frame, cropped to its box,
+// or a switching workspace's windows
+struct SSnapshot {
+    CFramebuffer* pFramebuffer = nullptr;  // from the pool, can be bigger than the box
+    wlr_box       box = {0, 0, 0, 0};      // monitor-local, in pixels
+    std::chrono::steady_clock::time_point captured;
+};
+
+// a program that isn't needed for the first frame, built on the shader thread
+// and set up (uniforms, VAO) on the main one once it's done or first needed
+struct SShaderJob {
+    std::string vert;
+    std::string frag;
+    GLuint      program = 0;
+    bool        built = false;        // under m_mShaderJobsMutex
+    int*        pAsyncJob = nullptr;  // the shader's asyncJob
+    std::function<void(GLuint)> setup;
 };
 
 class CHyprOpenGLImpl {
 public:
 
     CHyprOpenGLImpl();
+    ~CHyprOpenGLImpl();
 
     void    begin(SMonitor*, pixman_region32_t*, bool fake = false);
     void    end();
@@ -59,8 +106,16 @@ public:
 
     void    makeWindowSnapshot(CWindow*);
     void    makeLayerSnapshot(SLayerSurface*);
+    void    makeWorkspaceSnapshot(CWorkspace*, SMonitor*);
     void    renderSnapshot(CWindow**);
     void    renderSnapshot(SLayerSurface**);
+    void    renderSnapshot(CWorkspace*);
+    void    releaseSnapshot(CWindow*);
+    void    releaseSnapshot(SLayerSurface*);
+    void    releaseSnapshot(CWorkspace*);
+
+    void    renderWorkspaceThumbnail(CWorkspace*, CFramebuffer*, const Vector2D& size);
+    bool    readFramebuffer(CFramebuffer*, void* pData);  // as xrgb8888, top row first
 
     void    clear(const CColor&);
     void    clearWithTex();
@@ -69,9 +124,23 @@ public:
     void    scissor(const int x, const int y, const int w, const int h);
 
     void    destroyMonitorResources(SMonitor*);
+    bool    releaseIdleBlurBuffers();  // returns whether any are still allocated
+
+    void    markBlurDirtyForMonitor(SMonitor*);
+    bool    preBlurQueued(SMonitor*);
+
+    bool    canReusePrimaryFB(SMonitor*);  // whether it still has the last frame, without the cursor
+    void    invalidatePrimaryFB(SMonitor*, const wlr_box&);  // box is monitor-local, in pixels
+    void    repairPrimaryFB(SMonitor*, pixman_region32_t*);  // adds what was invalidated to the frame's damage
+    void    preWindowPass();
+
+    void    flushRectBatch();
+    void    releaseStateForWLR();
 
     SCurrentRenderData m_RenderData;
 
+    CGLState m_sGLState;
+
     GLint  m_iCurrentOutputFb = 0;
     GLint  m_iWLROutputFb = 0;
 
@@ -79,8 +148,18 @@ public:
 
     pixman_region32_t m_rOriginalDamageRegion; // used for storing the pre-expanded region
 
-    std::unordered_map<CWindow*, CFramebuffer> m_mWindowFramebuffers;
-    std::unordered_map<SLayerSurface*, CFramebuffer> m_mLayerFramebuffers;
+    CGPUResourceRegistry m_sGPUResources;
+
+    CShaderCache m_sShaderCache;
+    int          m_iShadersBuiltAsync = 0;
+    int          m_iShaderWaits = 0;       // times a frame had to wait for the shader thread
+    float        m_fShaderInitMs = 0;      // on the main thread, before the first frame
+    float        m_fFirstFrameMs = -1;     // since the compositor started
+
+    std::unordered_map<CWindow*, SSnapshot> m_mWindowFramebuffers;
+    std::unordered_map<SLayerSurface*, SSnapshot> m_mLayerFramebuffers;
+    std::unordered_map<CWorkspace*, SSnapshot> m_mWorkspaceFramebuffers;
+    CFramebufferPool m_sSnapshotPool;
     std::unordered_map<SMonitor*, SMonitorRenderData> m_mMonitorRenderResources;
     std::unordered_map<SMonitor*, CTexture> m_mMonitorBGTextures;
 
@@ -90,25 +169,55 @@ private:
 
     int                     m_iDRMFD;
     std::string             m_szExtensions;
+    bool                    m_bReadBGRA = false;  // GL_EXT_read_format_bgra
 
     bool                    m_bFakeFrame = false;
     bool                    m_bEndFrame = false;
 
+    // Geometry
+    GLuint                  m_iFullVertsVBO = 0;
+    GLuint                  m_iRectBatchVBO = 0;
+    std::vector<float>      m_vRectBatch;  // x, y, r, g, b, a per vertex, in clip space
+
     // Shaders
-    SQuad                   m_shQUAD;
-    CShader                 m_shRGBA;
-    CShader                 m_shRGBX;
-    CShader                 m_shEXT;
+    SQuad                   m_shQUAD[SHADER_CORNERS_COUNT];
+    SQuadBatch              m_shQUADBATCH;
+    CShader                 m_shRGBA[SHADER_CORNERS_COUNT][2];  // [corners][discardOpaque]
+    CShader                 m_shRGBX[SHADER_CORNERS_COUNT][2];
+    CShader                 m_shEXT[SHADER_CORNERS_COUNT][2];
     CShader                 m_shBLUR1;
     CShader                 m_shBLUR2;
     //
 
+    // shader thread
+    std::vector<SShaderJob> m_vShaderJobs;  // not touched after the thread starts, apart from program and built
+    std::mutex              m_mShaderJobsMutex;
+    std::condition_variable m_cvShaderJobs;
+    std::thread             m_tShaderThread;
+    std::atomic<bool>       m_bShaderThreadExit = false;
+    int                     m_iShaderJobsPending = 0;
+
     GLuint                  createProgram(const std::string&, const std::string&);
     GLuint                  compileShader(const GLuint&, std::string);
+    void                    addShader(int* pAsyncJob, const std::string& vert, const std::string& frag, bool async, std::function<void(GLuint)> setup);
+    void                    addTexShader(CShader*, const std::string& frag, bool async);
+    void                    startShaderThread();
+    void                    buildShaderJobs();
+    bool                    finishShaderJob(int, bool wait);
+    void                    finishShaderJobs();
+    EGLContext              createSharedContext();
+    void                    copyToSnapshot(SSnapshot*, SMonitor*);
+    eShaderCorners          getShaderCorners(int round, bool allowAA);
     void                    createBGTextureForMonitor(SMonitor*);
+    void                    allocBlurBuffers();
+    void                    releaseBlurBuffers(SMonitorRenderData*);
+    void                    createVAO(GLuint* vao, GLint posAttrib, GLint texAttrib);
+    void                    bindGeometry(GLuint vao, GLint posAttrib, GLint texAttrib);
 
     // returns the out FB, can be either Mirror or MirrorSwap
     CFramebuffer*           blurMainFramebufferWithDamage(float a, wlr_box* pBox, pixman_region32_t* damage);
+    void                    preBlurForCurrentMonitor();
+    bool                    shouldUseCachedBlur();
 
     void                    renderTextureInternalWithDamage(const CTexture&, wlr_box* pBox, float a, pixman_region32_t* damage, int round = 0, bool discardOpaque = false, bool border = false, bool noAA = false);
     void                    renderBorder(wlr_box*, const CColor&, int thick = 1, int round = 0);
@@ -32,9 +32,11 @@ void renderSurface(struct wlr_surface* surface, int x, int y, void* data) {
 }
 
 bool CHyprRenderer::shouldRenderWindow(CWindow* pWindow, SMonitor* pMonitor) {
-    wlr_box geometry = pWindow->getFullWindowBoundingBox();
+    const wlr_box GEOMETRY = pWindow->getFullWindowBoundingBox();
+    const wlr_box MONITORBOX = {pMonitor->vecPosition.x, pMonitor->vecPosition.y, pMonitor->vecSize.x, pMonitor->vecSize.y};
+    wlr_box intersection;
 
-    if (!wlr_output_layout_intersects(g_pCompositor->m_sWLROutputLayout, pMonitor->output, &geometry))
+    if (!wlr_box_intersection(&intersection, &GEOMETRY, &MONITORBOX))
         return false;
 
     // now check if it has the same workspace
@@ -73,40 +75,123 @@ bool CHyprRenderer::shouldRenderWindow(CWindow* pWindow) {
     return false;
 }
 
-void CHyprRenderer::renderWorkspaceWithFullscreenWindow(SMonitor* pMonitor, CWorkspace* pWorkspace, timespec* time) {
-    CWindow* pWorkspaceWindow = nullptr;
+// windowValidMapped without the windowExists scan, the render lists only hold existing windows
+static bool isWindowRenderable(CWindow* pWindow) {
+    if (pWindow->m_bFadingOut)
+        return true;
 
-    for (auto& w : g_pCompositor->m_lWindows) {
-        if (w.m_iWorkspaceID != pWorkspace->m_iID || !w.m_bIsFullscreen)
-            continue;
+    if (!pWindow->m_bIsMapped || pWindow->m_bHidden)
+        return false;
+
+    if (pWindow->m_bIsX11 && !pWindow->m_bMappedX11)
+        return false;
+
+    return g_pXWaylandManager->getWindowSurface(pWindow);
+}
+
+void CHyprRenderer::invalidateRenderList() {
+    m_bRenderListDirty = true;
+
+    // windows moved between workspaces
+    if (g_pThumbnailManager)
+        g_pThumbnailManager->damageAll();
+}
+
+void CHyprRenderer::updateRenderList() {
+    if (!m_bRenderListDirty)
+        return;
+
+    for (auto& [id, list] : m_mRenderLists)
+        list.clear();
 
-        // found it!
-        renderWindow(&w, pMonitor, time, pWorkspace->m_efFullscreenMode != FULLSCREEN_FULL);
+    size_t zIndex = 0;
+    for (auto& w : g_pCompositor->m_lWindows)
+        m_mRenderLists[w.m_iWorkspaceID].push_back({&w, zIndex++});
 
-        pWorkspaceWindow = &w;
+    // drop the ones of workspaces that are gone
+    for (auto it = m_mRenderLists.begin(); it != m_mRenderLists.end();) {
+        if (it->second.empty())
+            it = m_mRenderLists.erase(it);
+        else
+            ++it;
     }
 
-    // then render windows over fullscreen
-    for (auto& w : g_pCompositor->m_lWindows) {
-        if (w.m_iWorkspaceID != pWorkspaceWindow->m_iWorkspaceID || !w.m_bCreatedOverFullscreen || !w.m_bIsMapped)
-            continue;
+    m_bRenderListDirty = false;
+}
+
+void CHyprRenderer::buildRenderQueue(SMonitor* pMonitor) {
+    updateRenderList();
+
+    m_vRenderQueue.clear();
+
+    // the workspaces shouldRenderWindow can say yes to
+    std::vector<int> workspaces;
+    const auto ADDWORKSPACE = [&](int id) {
+        if (std::find(workspaces.begin(), workspaces.end(), id) == workspaces.end())
+            workspaces.push_back(id);
+    };
+
+    for (auto& m : g_pCompositor->m_lMonitors) {
+        ADDWORKSPACE(m.activeWorkspace);
 
-        renderWindow(&w, pMonitor, time, true);
+        if (m.specialWorkspaceOpen)
+            ADDWORKSPACE(SPECIAL_WORKSPACE_ID);
     }
 
-    // and then special windows
-    for (auto& w : g_pCompositor->m_lWindows) {
-        if (!g_pCompositor->windowValidMapped(&w) && !w.m_bFadingOut)
-            continue;
+    for (auto& ws : g_pCompositor->m_lWorkspaces) {
+        if (ws.m_iMonitorID == pMonitor->ID && (ws.m_vRenderOffset.isBeingAnimated() || ws.m_fAlpha.isBeingAnimated()))
+            ADDWORKSPACE(ws.m_iID);
+    }
 
-        if (w.m_iWorkspaceID != SPECIAL_WORKSPACE_ID)
-            continue;
+    size_t listsUsed = 0;
+    for (auto& id : workspaces) {
+        const auto IT = m_mRenderLists.find(id);
 
-        if (!shouldRenderWindow(&w, pMonitor))
+        if (IT == m_mRenderLists.end())
             continue;
 
-        // render the bad boy
-        renderWindow(&w, pMonitor, time, true);
+        m_vRenderQueue.insert(m_vRenderQueue.end(), IT->second.begin(), IT->second.end());
+        listsUsed++;
+    }
+
+    // each list is in order already
+    if (listsUsed > 1)
+        std::sort(m_vRenderQueue.begin(), m_vRenderQueue.end(), [](const SRenderListEntry& a, const SRenderListEntry& b) { return a.zIndex < b.zIndex; });
+}
+
+void CHyprRenderer::renderWorkspaceWithFullscreenWindow(SMonitor* pMonitor, CWorkspace* pWorkspace, timespec* time) {
+    updateRenderList();
+
+    if (const auto IT = m_mRenderLists.find(pWorkspace->m_iID); IT != m_mRenderLists.end()) {
+        for (auto& e : IT->second) {
+            if (!e.pWindow->m_bIsFullscreen)
+                continue;
+
+            // found it!
+            renderWindow(e.pWindow, pMonitor, time, pWorkspace->m_efFullscreenMode != FULLSCREEN_FULL);
+        }
+
+        // then render windows over fullscreen
+        for (auto& e : IT->second) {
+            if (!e.pWindow->m_bCreatedOverFullscreen || !e.pWindow->m_bIsMapped)
+                continue;
+
+            renderWindow(e.pWindow, pMonitor, time, true);
+        }
+    }
+
+    // and then special windows
+    if (const auto IT = m_mRenderLists.find(SPECIAL_WORKSPACE_ID); IT != m_mRenderLists.end()) {
+        for (auto& e : IT->second) {
+            if (!isWindowRenderable(e.pWindow))
+                continue;
+
+            if (!shouldRenderWindow(e.pWindow, pMonitor))
+                continue;
+
+            // render the bad boy
+            renderWindow(e.pWindow, pMonitor, time, true);
+        }
     }
 
     // and the overlay layers
@@ -128,7 +213,7 @@ void CHyprRenderer::renderWorkspaceWithFullscreenWindow(SMonitor* pMonitor, CWor
         g_pHyprError->draw();
 }
 
-void CHyprRenderer::renderWindow(CWindow* pWindow, SMonitor* pMonitor, timespec* time, bool decorate) {
+void CHyprRenderer::renderWindow(CWindow* pWindow, SMonitor* pMonitor, timespec* time, bool decorate, bool ignoreWorkspaceAnim) {
     if (pWindow->m_bHidden)
         return;
 
@@ -139,13 +224,13 @@ void CHyprRenderer::renderWindow(CWindow* pWindow, SMonitor* pMonitor, timespec*
     }
     
     const auto PWORKSPACE = g_pCompositor->getWorkspaceByID(pWindow->m_iWorkspaceID);
-    const auto REALPOS = pWindow->m_vRealPosition.vec() + PWORKSPACE->m_vRenderOffset.vec();
+    const auto REALPOS = pWindow->m_vRealPosition.vec() + (ignoreWorkspaceAnim ? Vector2D() : PWORKSPACE->m_vRenderOffset.vec());
     SRenderData renderdata = {pMonitor->output, time, REALPOS.x, REALPOS.y};
     renderdata.surface = g_pXWaylandManager->getWindowSurface(pWindow);
     renderdata.w = std::clamp(pWindow->m_vRealSize.vec().x, (double)5, (double)1337420); // clamp the size to min 5,
     renderdata.h = std::clamp(pWindow->m_vRealSize.vec().y, (double)5, (double)1337420); // otherwise we'll have issues later with invalid boxes
     renderdata.dontRound = pWindow->m_bIsFullscreen && PWORKSPACE->m_efFullscreenMode == FULLSCREEN_FULL;
-    renderdata.fadeAlpha = pWindow->m_fAlpha.fl() * (PWORKSPACE->m_fAlpha.fl() / 255.f);
+    renderdata.fadeAlpha = pWindow->m_fAlpha.fl() * (ignoreWorkspaceAnim ? 1.f : PWORKSPACE->m_fAlpha.fl() / 255.f);
     renderdata.alpha = pWindow->m_bIsFullscreen ? g_pConfigManager->getFloat("decoration:fullscreen_opacity") : pWindow == g_pCompositor->m_pLastWindow ? g_pConfigManager->getFloat("decoration:active_opacity") : g_pConfigManager->getFloat("decoration:inactive_opacity");
     renderdata.decorate = decorate && !pWindow->m_bX11DoesntWantBorders;
     renderdata.rounding = pWindow->m_sAdditionalConfigData.rounding;
@@ -178,6 +263,58 @@ void CHyprRenderer::renderWindow(CWindow* pWindow, SMonitor* pMonitor, timespec*
     g_pHyprOpenGL->m_pCurrentWindow = nullptr;
 }
 
+// for the workspace snapshots: all of its windows, as if it wasn't moving
+void CHyprRenderer::renderWorkspaceWindows(CWorkspace* pWorkspace, SMonitor* pMonitor, timespec* time) {
+    updateRenderList();
+
+    const auto IT = m_mRenderLists.find(pWorkspace->m_iID);
+
+    if (IT == m_mRenderLists.end())
+        return;
+
+    // tiled, then floating on top
+    for (const bool FLOATING : {false, true}) {
+        for (auto& e : IT->second) {
+            if (!isWindowRenderable(e.pWindow) || e.pWindow->m_bIsFloating != FLOATING)
+                continue;
+
+            renderWindow(e.pWindow, pMonitor, time, true, true);
+        }
+    }
+}
+
+void CHyprRenderer::updateWorkspaceSnapshots(SMonitor* pMonitor) {
+    // switching workspaces moves (or fades) all of their windows at once, so with this on
+    // they're captured into one texture each when the switch starts and just that gets drawn.
+    // Live content is refreshed at workspaces_snapshot_refresh Hz, never if 0.
+    const bool ENABLED = g_pConfigManager->getInt("animations:workspaces_snapshot");
+    const auto REFRESHHZ = g_pConfigManager->getInt("animations:workspaces_snapshot_refresh");
+    const auto PACTIVEWORKSPACE = g_pCompositor->getWorkspaceByID(pMonitor->activeWorkspace);
+
+    // a fullscreen active workspace doesn't draw the others at all
+    const bool USABLE = ENABLED && PACTIVEWORKSPACE && !PACTIVEWORKSPACE->m_bHasFullscreenWindow;
+
+    const auto NOW = std::chrono::steady_clock::now();
+
+    for (auto& ws : g_pCompositor->m_lWorkspaces) {
+        if (ws.m_iMonitorID != pMonitor->ID)
+            continue;
+
+        const bool SWITCHING = !ws.m_bIsSpecialWorkspace && (ws.m_vRenderOffset.isBeingAnimated() || ws.m_fAlpha.isBeingAnimated());
+
+        if (!USABLE || !SWITCHING) {
+            g_pHyprOpenGL->releaseSnapshot(&ws);
+            continue;
+        }
+
+        const auto IT = g_pHyprOpenGL->m_mWorkspaceFramebuffers.find(&ws);
+        if (IT != g_pHyprOpenGL->m_mWorkspaceFramebuffers.end() && (REFRESHHZ <= 0 || NOW - IT->second.captured < std::chrono::milliseconds(1000 / REFRESHHZ)))
+            continue;
+
+        g_pHyprOpenGL->makeWorkspaceSnapshot(&ws, pMonitor);
+    }
+}
+
 void CHyprRenderer::renderLayer(SLayerSurface* pLayer, SMonitor* pMonitor, timespec* time) {
     if (pLayer->fadingOut) {
         g_pHyprOpenGL->renderSnapshot(&pLayer);
@@ -212,55 +349,87 @@ void CHyprRenderer::renderAllClientsForMonitor(const int& ID, timespec* time) {
         return;
     }
 
+    // the background is done, cache its blur if needed
+    g_pHyprOpenGL->preWindowPass();
+
+    buildRenderQueue(PMONITOR);
+
+    // switching workspaces with a snapshot, the outgoing one below.
+    // their windows are skipped below
+    m_vSnapshotWorkspaces.clear();
+    for (auto& [PWORKSPACESNAP, snapshot] : g_pHyprOpenGL->m_mWorkspaceFramebuffers) {
+        if (PWORKSPACESNAP->m_iMonitorID == PMONITOR->ID && PWORKSPACESNAP != PWORKSPACE)
+            m_vSnapshotWorkspaces.push_back(PWORKSPACESNAP->m_iID);
+    }
+    if (g_pHyprOpenGL->m_mWorkspaceFramebuffers.contains(PWORKSPACE))
+        m_vSnapshotWorkspaces.push_back(PWORKSPACE->m_iID);
+
+    for (auto& id : m_vSnapshotWorkspaces)
+        g_pHyprOpenGL->renderSnapshot(g_pCompositor->getWorkspaceByID(id));
+
+    const auto FROMSNAPSHOT = [&](CWindow* pWindow) { return !m_vSnapshotWorkspaces.empty() && std::find(m_vSnapshotWorkspaces.begin(), m_vSnapshotWorkspaces.end(), pWindow->m_iWorkspaceID) != m_vSnapshotWorkspaces.end(); };
+
     // Non-floating
-    for (auto& w : g_pCompositor->m_lWindows) {
-        if (!g_pCompositor->windowValidMapped(&w) && !w.m_bFadingOut)
+    for (auto& e : m_vRenderQueue) {
+        const auto PWINDOW = e.pWindow;
+
+        if (!isWindowRenderable(PWINDOW))
             continue;
 
-        if (w.m_bIsFloating)
+        if (PWINDOW->m_bIsFloating)
             continue;  // floating are in the second pass
 
-        if (w.m_iWorkspaceID == SPECIAL_WORKSPACE_ID)
+        if (FROMSNAPSHOT(PWINDOW))
+            continue;
+
+        if (PWINDOW->m_iWorkspaceID == SPECIAL_WORKSPACE_ID)
             continue; // special are in the third pass
 
-        if (!shouldRenderWindow(&w, PMONITOR))
+        if (!shouldRenderWindow(PWINDOW, PMONITOR))
             continue;
 
         // render the bad boy
-        renderWindow(&w, PMONITOR, time, true);
+        renderWindow(PWINDOW, PMONITOR, time, true);
     }
 
     // floating on top
-    for (auto& w : g_pCompositor->m_lWindows) {
-        if (!g_pCompositor->windowValidMapped(&w) && !w.m_bFadingOut)
+    for (auto& e : m_vRenderQueue) {
+        const auto PWINDOW = e.pWindow;
+
+        if (!isWindowRenderable(PWINDOW))
             continue;
 
-        if (!w.m_bIsFloating)
+        if (!PWINDOW->m_bIsFloating)
             continue;
 
-        if (w.m_iWorkspaceID == SPECIAL_WORKSPACE_ID)
+        if (FROMSNAPSHOT(PWINDOW))
             continue;
 
-        if (!shouldRenderWindow(&w, PMONITOR))
+        if (PWINDOW->m_iWorkspaceID == SPECIAL_WORKSPACE_ID)
+            continue;
+
+        if (!shouldRenderWindow(PWINDOW, PMONITOR))
             continue;
 
         // render the bad boy
-        renderWindow(&w, PMONITOR, time, true);
+        renderWindow(PWINDOW, PMONITOR, time, true);
     }
 
     // and then special
-    for (auto& w : g_pCompositor->m_lWindows) {
-        if (!g_pCompositor->windowValidMapped(&w) && !w.m_bFadingOut)
+    for (auto& e : m_vRenderQueue) {
+        const auto PWINDOW = e.pWindow;
+
+        if (!isWindowRenderable(PWINDOW))
             continue;
-            
-        if (w.m_iWorkspaceID != SPECIAL_WORKSPACE_ID)
+
+        if (PWINDOW->m_iWorkspaceID != SPECIAL_WORKSPACE_ID)
             continue;
 
-        if (!shouldRenderWindow(&w, PMONITOR))
+        if (!shouldRenderWindow(PWINDOW, PMONITOR))
             continue;
 
         // render the bad boy
-        renderWindow(&w, PMONITOR, time, true);
+        renderWindow(PWINDOW, PMONITOR, time, true);
     }
 
     // Render surfaces above windows for monitor
@@ -512,6 +681,46 @@ void CHyprRenderer::arrangeLayersForMonitor(const int& monitor) {
     Debug::log(LOG, "Monitor %s layers arranged: reserved: %f %f %f %f", PMONITOR->szName.c_str(), PMONITOR->vecReservedTopLeft.x, PMONITOR->vecReservedTopLeft.y, PMONITOR->vecReservedBottomRight.x, PMONITOR->vecReservedBottomRight.y);
 }
 
+// box is in layout coords, only goes to the monitors it actually touches
+static void damageBoxOnMonitors(const wlr_box& box) {
+    g_pCompositor->m_sMonitorLayoutIndex.forEachIntersecting(box, [](SMonitor* pMonitor, const wlr_box& intersection) {
+        if (!pMonitor->damage)
+            return;
+
+        wlr_box fixedDamageBox = {intersection.x - pMonitor->vecPosition.x, intersection.y - pMonitor->vecPosition.y, intersection.width, intersection.height};
+        scaleBox(&fixedDamageBox, pMonitor->scale);
+        wlr_output_damage_add_box(pMonitor->damage, &fixedDamageBox);
+        pMonitor->hasSceneDamage = true;
+        pMonitor->damageCalls++;
+    });
+}
+
+void CHyprRenderer::damageRegion(pixman_region32_t* pRegion) {
+    if (!pixman_region32_not_empty(pRegion))
+        return;
+
+    const auto EXTENTS = pixman_region32_extents(pRegion);
+    const wlr_box EXTENTSBOX = {EXTENTS->x1, EXTENTS->y1, EXTENTS->x2 - EXTENTS->x1, EXTENTS->y2 - EXTENTS->y1};
+
+    g_pCompositor->m_sMonitorLayoutIndex.forEachIntersecting(EXTENTSBOX, [&](SMonitor* pMonitor, const wlr_box& intersection) {
+        if (!pMonitor->damage)
+            return;
+
+        pixman_region32_t monitorDamage;
+        pixman_region32_init(&monitorDamage);
+        pixman_region32_intersect_rect(&monitorDamage, pRegion, intersection.x, intersection.y, intersection.width, intersection.height);
+        pixman_region32_translate(&monitorDamage, -pMonitor->vecPosition.x, -pMonitor->vecPosition.y);
+        wlr_region_scale(&monitorDamage, &monitorDamage, pMonitor->scale);
+        wlr_output_damage_add(pMonitor->damage, &monitorDamage);
+        pixman_region32_fini(&monitorDamage);
+        pMonitor->hasSceneDamage = true;
+        pMonitor->damageCalls++;
+    });
+
+    if (g_pConfigManager->getInt("debug:log_damage"))
+        Debug::log(LOG, "Damage: Region (extents): xy: %d, %d wh: %d, %d", EXTENTSBOX.x, EXTENTSBOX.y, EXTENTSBOX.width, EXTENTSBOX.height);
+}
+
 void CHyprRenderer::damageSurface(wlr_surface* pSurface, double x, double y) {
     if (!pSurface)
         return; // wut?
@@ -522,34 +731,46 @@ void CHyprRenderer::damageSurface(wlr_surface* pSurface, double x, double y) {
 
     pixman_region32_translate(&damageBox, x, y);
 
-    for (auto& m : g_pCompositor->m_lMonitors) {
-        double lx = 0, ly = 0;
-        wlr_output_layout_output_coords(g_pCompositor->m_sWLROutputLayout, m.output, &lx, &ly);
-        pixman_region32_translate(&damageBox, lx, ly);
-        wlr_region_scale(&damageBox, &damageBox, m.scale);
-        wlr_output_damage_add(m.damage, &damageBox);
-        pixman_region32_translate(&damageBox, -lx, -ly);
+    // frame callbacks only go out with a frame, and no damage means no frame
+    if (!pixman_region32_not_empty(&damageBox) && !wl_list_empty(&pSurface->current.frame_callback_list)) {
+        const wlr_box SURFACEBOX = {(int)x, (int)y, pSurface->current.width, pSurface->current.height};
+        g_pCompositor->m_sMonitorLayoutIndex.forEachIntersecting(SURFACEBOX, [](SMonitor* pMonitor, const wlr_box& intersection) {
+            pMonitor->wantsFrameCallbacks = true;
+            wlr_output_schedule_frame(pMonitor->output);
+        });
     }
 
+    damageRegion(&damageBox);
+
     pixman_region32_fini(&damageBox);
+}
 
-    if (g_pConfigManager->getInt("debug:log_damage"))
-        Debug::log(LOG, "Damage: Surface (extents): xy: %d, %d wh: %d, %d", damageBox.extents.x1, damageBox.extents.y1, damageBox.extents.x2 - damageBox.extents.x1, damageBox.extents.y2 - damageBox.extents.y1);
+static void sendFrameDone(wlr_surface* surface, int x, int y, void* data) {
+    wlr_surface_send_frame_done(surface, (timespec*)data);
+}
+
+void CHyprRenderer::sendFrameCallbacks(SMonitor* pMonitor, timespec* now) {
+    // for frames that don't render the clients, what renderSurface would've sent
+    for (auto& w : g_pCompositor->m_lWindows) {
+        if (!w.m_bIsMapped || w.m_bHidden || w.m_bFadingOut || !shouldRenderWindow(&w, pMonitor))
+            continue;
+
+        wlr_surface_for_each_surface(g_pXWaylandManager->getWindowSurface(&w), sendFrameDone, now);
+
+        if (!w.m_bIsX11)
+            wlr_xdg_surface_for_each_popup_surface(w.m_uSurface.xdg, sendFrameDone, now);
+    }
 }
 
 void CHyprRenderer::damageWindow(CWindow* pWindow) {
+    g_pThumbnailManager->damageWorkspace(pWindow->m_iWorkspaceID);
+
     if (!pWindow->m_bIsFloating) {
         // damage by size & pos
         // TODO TEMP: revise when added shadows/etc
 
         wlr_box damageBox = {pWindow->m_vRealPosition.vec().x, pWindow->m_vRealPosition.vec().y, pWindow->m_vRealSize.vec().x, pWindow->m_vRealSize.vec().y};
-        for (auto& m : g_pCompositor->m_lMonitors) {
-            wlr_box fixedDamageBox = damageBox;
-            fixedDamageBox.x -= m.vecPosition.x;
-            fixedDamageBox.y -= m.vecPosition.y;
-            scaleBox(&fixedDamageBox, m.scale);
-            wlr_output_damage_add_box(m.damage, &fixedDamageBox);
-        }
+        damageBoxOnMonitors(damageBox);
 
         if (g_pConfigManager->getInt("debug:log_damage"))
             Debug::log(LOG, "Damage: Window floated (%s): xy: %d, %d wh: %d, %d", pWindow->m_szTitle.c_str(), damageBox.x, damageBox.y, damageBox.width, damageBox.height);
@@ -557,13 +778,7 @@ void CHyprRenderer::damageWindow(CWindow* pWindow) {
         // damage by real size & pos + border size * 2 (JIC)
         const auto BORDERSIZE = g_pConfigManager->getInt("general:border_size");
         wlr_box damageBox = { pWindow->m_vRealPosition.vec().x - BORDERSIZE - 1, pWindow->m_vRealPosition.vec().y - BORDERSIZE - 1, pWindow->m_vRealSize.vec().x + 2 * BORDERSIZE + 2, pWindow->m_vRealSize.vec().y + 2 * BORDERSIZE + 2};
-        for (auto& m : g_pCompositor->m_lMonitors) {
-            wlr_box fixedDamageBox = damageBox;
-            fixedDamageBox.x -= m.vecPosition.x;
-            fixedDamageBox.y -= m.vecPosition.y;
-            scaleBox(&fixedDamageBox, m.scale);
-            wlr_output_damage_add_box(m.damage, &fixedDamageBox);
-        }
+        damageBoxOnMonitors(damageBox);
 
         if (g_pConfigManager->getInt("debug:log_damage"))
             Debug::log(LOG, "Damage: Window tiled (%s): xy: %d, %d wh: %d, %d", pWindow->m_szTitle.c_str(), damageBox.x, damageBox.y, damageBox.width, damageBox.height);
@@ -573,17 +788,15 @@ void CHyprRenderer::damageWindow(CWindow* pWindow) {
 void CHyprRenderer::damageMonitor(SMonitor* pMonitor) {
     wlr_box damageBox = {0, 0, pMonitor->vecPixelSize.x, pMonitor->vecPixelSize.y};
     wlr_output_damage_add_box(pMonitor->damage, &damageBox);
+    pMonitor->hasSceneDamage = true;
+    pMonitor->damageCalls++;
 
     if (g_pConfigManager->getInt("debug:log_damage"))
         Debug::log(LOG, "Damage: Monitor %s", pMonitor->szName.c_str());
 }
 
 void CHyprRenderer::damageBox(wlr_box* pBox) {
-    for (auto& m : g_pCompositor->m_lMonitors) {
-        wlr_box damageBox = {pBox->x - m.vecPosition.x, pBox->y - m.vecPosition.y, pBox->width, pBox->height};
-        scaleBox(&damageBox, m.scale);
-        wlr_output_damage_add_box(m.damage, &damageBox);
-    }
+    damageBoxOnMonitors(*pBox);
 
     if (g_pConfigManager->getInt("debug:log_damage"))
         Debug::log(LOG, "Damage: Box: xy: %d, %d wh: %d, %d", pBox->x, pBox->y, pBox->width, pBox->height);
@@ -2,6 +2,8 @@
 
 #include "../defines.hpp"
 #include <list>
+#include <unordered_map>
+#include <vector>
 #include "../helpers/Monitor.hpp"
 #include "../helpers/Workspace.hpp"
 #include "../Window.hpp"
@@ -24,23 +26,49 @@ public:
     void                outputMgrApplyTest(wlr_output_configuration_v1*, bool);
     void                arrangeLayersForMonitor(const int&);
     void                damageSurface(wlr_surface*, double, double);
+    void                sendFrameCallbacks(SMonitor*, timespec*);
     void                damageWindow(CWindow*);
     void                damageBox(wlr_box*);
     void                damageBox(const int& x, const int& y, const int& w, const int& h);
     void                damageMonitor(SMonitor*);
+    void                damageRegion(pixman_region32_t*);  // layout coords, split per monitor
     void                applyMonitorRule(SMonitor*, SMonitorRule*, bool force = false);
     bool                shouldRenderWindow(CWindow*, SMonitor*);
     bool                shouldRenderWindow(CWindow*);
 
+    // call when a window gets added / removed / restacked or changes its workspace
+    void                invalidateRenderList();
+
+    // (re)captures the workspaces switching on the monitor, call before rendering it
+    void                updateWorkspaceSnapshots(SMonitor*);
+
     DAMAGETRACKINGMODES damageTrackingModeFromStr(const std::string&);
 
 private:
     void                arrangeLayerArray(SMonitor*, const std::list<SLayerSurface*>&, bool, wlr_box*);
     void                renderWorkspaceWithFullscreenWindow(SMonitor*, CWorkspace*, timespec*);
-    void                renderWindow(CWindow*, SMonitor*, timespec*, bool);
+    void                renderWindow(CWindow*, SMonitor*, timespec*, bool, bool ignoreWorkspaceAnim = false);
+    void                renderWorkspaceWindows(CWorkspace*, SMonitor*, timespec*);
     void                renderLayer(SLayerSurface*, SMonitor*, timespec*);
     void                renderDragIcon(SMonitor*, timespec*);
+    void                updateRenderList();
+    void                buildRenderQueue(SMonitor*);
+
+    struct SRenderListEntry {
+        CWindow*        pWindow = nullptr;
+        size_t          zIndex = 0;  // position in m_lWindows, bottom to top
+    };
+
+    // workspace ID -> its windows, bottom to top. Rebuilt only when invalidated,
+    // so that a frame only walks the windows of workspaces that can be seen
+    std::unordered_map<int, std::vector<SRenderListEntry>> m_mRenderLists;
+    bool                m_bRenderListDirty = true;
+
+    // windows that might be on the monitor being rendered, bottom to top. Reused every frame
+    std::vector<SRenderListEntry> m_vRenderQueue;
 
+    // workspaces drawn from their snapshot this frame, their windows are skipped
+    std::vector<int>    m_vSnapshotWorkspaces;
 
     friend class CHyprOpenGLImpl;
 };
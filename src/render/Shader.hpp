@@ -2,12 +2,36 @@
 
 #include "../defines.hpp"
 
+// shader variants for the corners, the defines for them are in Shaders.hpp
+enum eShaderCorners {
+    SHADER_CORNERS_SQUARE = 0,      // trivial, no rounding code at all
+    SHADER_CORNERS_ROUNDED,         // rounded, hard edges
+    SHADER_CORNERS_ROUNDED_AA,      // rounded, antialiased (decoration:multisample_edges)
+    SHADER_CORNERS_COUNT
+};
+
 struct SQuad {
     GLuint program;
     GLint proj;
     GLint color;
     GLint posAttrib;
     GLint texAttrib;
+
+    GLint fullSize;
+    GLint radius;
+
+    GLuint vao = 0;
+
+    int asyncJob = -1;  // still building on the shader thread if not -1, see CHyprOpenGLImpl::finishShaderJob
+};
+
+// solid, unrounded rects with the color per vertex, for batching
+struct SQuadBatch {
+    GLuint program;
+    GLint posAttrib;
+    GLint colorAttrib;
+
+    GLuint vao = 0;
 };
 
 class CShader {
@@ -18,5 +42,14 @@ public:
     GLint alpha;
     GLint posAttrib;
     GLint texAttrib;
-    GLint discardOpaque;
-};
\ No newline at end of file
+
+    GLint fullSize;
+    GLint radius;
+
+    GLint halfpixel;
+    GLint texscale;
+
+    GLuint vao = 0;
+
+    int asyncJob = -1;  // still building on the shader thread if not -1, see CHyprOpenGLImpl::finishShaderJob
+};
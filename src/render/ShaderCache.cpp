@@ -0,0 +1,167 @@
+#include "ShaderCache.hpp"
+#include "../helpers/MiscFunctions.hpp"
+
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <unistd.h>
+
+#ifdef GLES2
+// only there with GL_OES_get_program_binary
+static PFNGLGETPROGRAMBINARYOESPROC glGetProgramBinary = nullptr;
+static PFNGLPROGRAMBINARYOESPROC    glProgramBinary = nullptr;
+#define GL_PROGRAM_BINARY_LENGTH GL_PROGRAM_BINARY_LENGTH_OES
+#define GL_NUM_PROGRAM_BINARY_FORMATS GL_NUM_PROGRAM_BINARY_FORMATS_OES
+#endif
+
+// FNV-1a, std::hash isn't guaranteed to be the same between builds
+static uint64_t hashString(uint64_t hash, const std::string& str) {
+    for (const unsigned char c : str) {
+        hash ^= c;
+        hash *= 1099511628211ULL;
+    }
+
+    return hash;
+}
+
+void CShaderCache::init() {
+#ifdef GLES2
+    const std::string EXTENSIONS = (const char*)glGetString(GL_EXTENSIONS);
+
+    if (EXTENSIONS.find("GL_OES_get_program_binary") != std::string::npos) {
+        glGetProgramBinary = (PFNGLGETPROGRAMBINARYOESPROC)eglGetProcAddress("glGetProgramBinaryOES");
+        glProgramBinary = (PFNGLPROGRAMBINARYOESPROC)eglGetProcAddress("glProgramBinaryOES");
+    }
+
+    if (!glGetProgramBinary || !glProgramBinary) {
+        Debug::log(LOG, "Shader cache: no GL_OES_get_program_binary, not caching");
+        return;
+    }
+#endif
+
+    GLint formats = 0;
+    glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formats);
+
+    if (formats <= 0) {
+        Debug::log(LOG, "Shader cache: the driver has no program binary formats, not caching");
+        return;
+    }
+
+    const char* const CACHEHOME = getenv("XDG_CACHE_HOME");
+    const char* const ENVHOME = getenv("HOME");
+
+    if ((!CACHEHOME || !*CACHEHOME) && !ENVHOME) {
+        Debug::log(WARN, "Shader cache: no XDG_CACHE_HOME or HOME, not caching");
+        return;
+    }
+
+    m_szDirectory = (CACHEHOME && *CACHEHOME ? std::string(CACHEHOME) : std::string(ENVHOME) + "/.cache") + "/hypr/shaders";
+
+    std::error_code ec;
+    std::filesystem::create_directories(m_szDirectory, ec);
+
+    if (ec) {
+        Debug::log(WARN, "Shader cache: couldn't create %s (%s), not caching", m_szDirectory.c_str(), ec.message().c_str());
+        return;
+    }
+
+    // the binaries are only good for the exact same driver build
+    m_szDriver = std::string((const char*)glGetString(GL_VENDOR)) + "|" + (const char*)glGetString(GL_RENDERER) + "|" + (const char*)glGetString(GL_VERSION);
+
+    m_bEnabled = true;
+
+    Debug::log(LOG, "Shader cache: using %s", m_szDirectory.c_str());
+}
+
+std::string CShaderCache::pathFor(const std::string& vert, const std::string& frag) {
+    uint64_t hash = 14695981039346656037ULL;
+    hash = hashString(hash, m_szDriver);
+    hash = hashString(hash, std::to_string(vert.length()) + ":" + vert);
+    hash = hashString(hash, std::to_string(frag.length()) + ":" + frag);
+
+    return getFormat("%s/%016llx.bin", m_szDirectory.c_str(), (unsigned long long)hash);
+}
+
+GLuint CShaderCache::load(const std::string& vert, const std::string& frag) {
+    if (!m_bEnabled)
+        return 0;
+
+    const auto PATH = pathFor(vert, frag);
+
+    std::ifstream file(PATH, std::ios::binary);
+
+    GLenum format = 0;
+    if (!file.good() || !file.read((char*)&format, sizeof(format))) {
+        m_iMisses++;
+        return 0;
+    }
+
+    const std::vector<char> BINARY((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+    if (BINARY.empty()) {
+        m_iMisses++;
+        return 0;
+    }
+
+    const auto PROG = glCreateProgram();
+    glProgramBinary(PROG, format, BINARY.data(), BINARY.size());
+
+    GLint ok = GL_FALSE;
+    glGetProgramiv(PROG, GL_LINK_STATUS, &ok);
+
+    if (ok == GL_FALSE) {
+        // drivers can refuse them even with the same version string, just rebuild it
+        Debug::log(LOG, "Shader cache: %s was rejected, rebuilding", PATH.c_str());
+
+        glDeleteProgram(PROG);
+
+        std::error_code ec;
+        std::filesystem::remove(PATH, ec);
+
+        m_iMisses++;
+        return 0;
+    }
+
+    m_iHits++;
+    return PROG;
+}
+
+void CShaderCache::save(GLuint program, const std::string& vert, const std::string& frag) {
+    if (!m_bEnabled)
+        return;
+
+    GLint length = 0;
+    glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+
+    if (length <= 0)
+        return;
+
+    std::vector<char> binary(length);
+    GLenum format = 0;
+    GLsizei written = 0;
+    glGetProgramBinary(program, length, &written, &format, binary.data());
+
+    if (written <= 0)
+        return;
+
+    // another instance might be reading it, so write it next to it and move it over
+    const auto PATH = pathFor(vert, frag);
+    const auto TMPPATH = PATH + "." + std::to_string(getpid());
+
+    std::ofstream file(TMPPATH, std::ios::binary | std::ios::trunc);
+    file.write((const char*)&format, sizeof(format));
+    file.write(binary.data(), written);
+    file.close();
+
+    std::error_code ec;
+
+    if (!file) {
+        std::filesystem::remove(TMPPATH, ec);
+        return;
+    }
+
+    std::filesystem::rename(TMPPATH, PATH, ec);
+
+    if (ec)
+        std::filesystem::remove(TMPPATH, ec);
+}
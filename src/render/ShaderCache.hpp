@@ -0,0 +1,26 @@
+#pragma once
+
+#include "../defines.hpp"
+#include <atomic>
+
+// Linked programs on disk, keyed by the driver and the sources, so that only
+// the first start after a driver or shader change has to compile anything.
+// Works with whatever context is current on the calling thread.
+class CShaderCache {
+public:
+    void            init();  // needs a current context
+
+    GLuint          load(const std::string& vert, const std::string& frag);  // 0 if it's not cached
+    void            save(GLuint program, const std::string& vert, const std::string& frag);
+
+    bool            m_bEnabled = false;
+
+    std::atomic<int> m_iHits = 0;
+    std::atomic<int> m_iMisses = 0;
+
+private:
+    std::string     pathFor(const std::string& vert, const std::string& frag);
+
+    std::string     m_szDriver = "";
+    std::string     m_szDirectory = "";
+};
@@ -2,144 +2,47 @@
 
 #include <string>
 
+// Shaders are compiled in variants, see eShaderCorners in Shader.hpp.
+// These are the defines prepended to the sources for each one, so that
+// the corner (and discard) code is compiled out instead of branched on.
+inline static constexpr auto SHADER_VARIANT_DEFINES = [](int corners, bool discardOpaque) -> std::string {
+    std::string defines = "";
+
+    if (corners != 0)
+        defines += "#define ROUNDED\n";
+    if (corners == 2)
+        defines += "#define MULTISAMPLE\n";
+    if (discardOpaque)
+        defines += "#define DISCARDOPAQUE\n";
+
+    return defines;
+};
+
+// Analytic coverage of a rounded rect, from the distance to the rounded corner.
+// Fragments outside of the corner arcs have a dist <= 0 so are left untouched.
 inline static constexpr auto ROUNDED_SHADER_FUNC = [](const std::string colorVarName) -> std::string {
     return R"#(
-		if (pixCoord[0] < topLeft[0]) {
-		// we're close left
-		if (pixCoord[1] < topLeft[1]) {
-			// top
-
-			if (ignoreCorners == 1) {
-				discard;
-				return;
-			}
-
-			float topLeftDistance = distance(topLeft, pixCoord);
-
-			if (topLeftDistance > radius - 1.0) {
-				if (primitiveMultisample == 0 && topLeftDistance > radius) {
-					discard;
-					return;
-				} else if (primitiveMultisample == 1) {
-					float distances = 0.0;
-					if (distance(topLeft, pixCoord + vec2(0.25, 0.25)) < radius) { distances = distances + 1.0; }
-					if (distance(topLeft, pixCoord + vec2(0.75, 0.25)) < radius) { distances = distances + 1.0; }
-					if (distance(topLeft, pixCoord + vec2(0.25, 0.75)) < radius) { distances = distances + 1.0; }
-					if (distance(topLeft, pixCoord + vec2(0.75, 0.75)) < radius) { distances = distances + 1.0; }
-
-					if (distances == 0.0) {
-						discard;
-						return;
-					}
-
-					distances = distances / 4.0;
-
-					gl_FragColor = )#" + colorVarName + R"#( * distances;
-					return;
-				}
-			}
-		} else if (pixCoord[1] > bottomRight[1]) {
-			// bottom
-
-			if (ignoreCorners == 1) {
-				discard;
-				return;
-			}
-
-			float topLeftDistance = distance(vec2(topLeft[0], bottomRight[1]), pixCoord);
-
-			if (topLeftDistance > radius - 1.0) {
-				if (primitiveMultisample == 0 && topLeftDistance > radius) {
-					discard;
-					return;
-				} else if (primitiveMultisample == 1) {
-					float distances = 0.0;
-					if (distance(vec2(topLeft[0], bottomRight[1]), pixCoord + vec2(0.25, 0.25)) < radius) { distances = distances + 1.0; }
-					if (distance(vec2(topLeft[0], bottomRight[1]), pixCoord + vec2(0.75, 0.25)) < radius) { distances = distances + 1.0; }
-					if (distance(vec2(topLeft[0], bottomRight[1]), pixCoord + vec2(0.25, 0.75)) < radius) { distances = distances + 1.0; }
-					if (distance(vec2(topLeft[0], bottomRight[1]), pixCoord + vec2(0.75, 0.75)) < radius) { distances = distances + 1.0; }
-
-					if (distances == 0.0) {
-						discard;
-						return;
-					}
-
-					distances = distances / 4.0;
-
-					gl_FragColor = )#" + colorVarName + R"#( * distances;
-					return;
-				}
-			}
-		}
+#ifdef ROUNDED
+	vec2 halfSize = fullSize * 0.5;
+	vec2 cornerDist = abs(pixCoord - halfSize) - halfSize + radius;
+	float dist = length(max(cornerDist, 0.0)) - radius;
+
+#ifdef MULTISAMPLE
+	float coverage = clamp(0.5 - dist, 0.0, 1.0);
+
+	if (coverage == 0.0) {
+		discard;
+		return;
 	}
-	else if (pixCoord[0] > bottomRight[0]) {
-		// we're close right
-		if (pixCoord[1] < topLeft[1]) {
-			// top
-
-			if (ignoreCorners == 1) {
-				discard;
-				return;
-			}
-
-			float topLeftDistance = distance(vec2(bottomRight[0], topLeft[1]), pixCoord);
-
-			if (topLeftDistance > radius - 1.0) {
-				if (primitiveMultisample == 0 && topLeftDistance > radius) {
-					discard;
-					return;
-				} else if (primitiveMultisample == 1) {
-					float distances = 0.0;
-					if (distance(vec2(bottomRight[0], topLeft[1]), pixCoord + vec2(0.25, 0.25)) < radius) { distances = distances + 1.0; }
-					if (distance(vec2(bottomRight[0], topLeft[1]), pixCoord + vec2(0.75, 0.25)) < radius) { distances = distances + 1.0; }
-					if (distance(vec2(bottomRight[0], topLeft[1]), pixCoord + vec2(0.25, 0.75)) < radius) { distances = distances + 1.0; }
-					if (distance(vec2(bottomRight[0], topLeft[1]), pixCoord + vec2(0.75, 0.75)) < radius) { distances = distances + 1.0; }
-
-					if (distances == 0.0) {
-						discard;
-						return;
-					}
-
-					distances = distances / 4.0;
-
-					gl_FragColor = )#" + colorVarName + R"#( * distances;
-					return;
-				}
-			}
-		} else if (pixCoord[1] > bottomRight[1]) {
-			// bottom
-
-			if (ignoreCorners == 1) {
-				discard;
-				return;
-			}
-
-			float topLeftDistance = distance(bottomRight, pixCoord);
-
-			if (topLeftDistance > radius - 1.0) {
-				if (primitiveMultisample == 0 && topLeftDistance > radius) {
-					discard;
-					return;
-				} else if (primitiveMultisample == 1) {
-					float distances = 0.0;
-					if (distance(bottomRight, pixCoord + vec2(0.25, 0.25)) < radius) { distances = distances + 1.0; }
-					if (distance(bottomRight, pixCoord + vec2(0.75, 0.25)) < radius) { distances = distances + 1.0; }
-					if (distance(bottomRight, pixCoord + vec2(0.25, 0.75)) < radius) { distances = distances + 1.0; }
-					if (distance(bottomRight, pixCoord + vec2(0.75, 0.75)) < radius) { distances = distances + 1.0; }
-
-					if (distances == 0.0) {
-						discard;
-						return;
-					}
-
-					distances = distances / 4.0;
-
-					gl_FragColor = )#" + colorVarName + R"#( * distances;
-					return;
-				}
-			}
-		}
+
+	)#" + colorVarName + R"#( = )#" + colorVarName + R"#( * coverage;
+#else
+	if (dist > 0.0) {
+		discard;
+		return;
 	}
+#endif
+#endif
 	)#";
 };
 
@@ -162,24 +65,36 @@ precision mediump float;
 varying vec4 v_color;
 varying vec2 v_texcoord;
 
-uniform vec2 topLeft;
-uniform vec2 bottomRight;
 uniform vec2 fullSize;
 uniform float radius;
 
-uniform int primitiveMultisample;
-uniform int ignoreCorners;
-
 void main() {
-	if (radius == 0.0) {
-		gl_FragColor = v_color;
-		return;
-	}
+	vec4 pixColor = v_color;
+
+#ifdef ROUNDED
+	vec2 pixCoord = fullSize * v_texcoord;
+#endif
+
+	)#" + ROUNDED_SHADER_FUNC("pixColor") + R"#(
+
+	gl_FragColor = pixColor;
+})#";
 
-    vec2 pixCoord = fullSize * v_texcoord;
+inline const std::string QUADBATCHVERTSRC = R"#(
+attribute vec2 pos;
+attribute vec4 color;
+varying vec4 v_color;
 
-	)#" + ROUNDED_SHADER_FUNC("v_color") + R"#(
+void main() {
+    gl_Position = vec4(pos, 0.0, 1.0);
+    v_color = color;
+})#";
 
+inline const std::string QUADBATCHFRAGSRC = R"#(
+precision mediump float;
+varying vec4 v_color;
+
+void main() {
 	gl_FragColor = v_color;
 })#";
 
@@ -200,29 +115,25 @@ varying vec2 v_texcoord; // is in 0-1
 uniform sampler2D tex;
 uniform float alpha;
 
-uniform vec2 topLeft;
-uniform vec2 bottomRight;
 uniform vec2 fullSize;
 uniform float radius;
 
-uniform int discardOpaque;
-
-uniform int primitiveMultisample;
-uniform int ignoreCorners;
-
 void main() {
 
 	vec4 pixColor = texture2D(tex, v_texcoord);
 
-	if (discardOpaque == 1 && pixColor[3] * alpha == 1.0) {
+#ifdef DISCARDOPAQUE
+	if (pixColor[3] * alpha == 1.0) {
 		discard;
 		return;
 	}
+#endif
 
+#ifdef ROUNDED
 	vec2 pixCoord = fullSize * v_texcoord;
+#endif
 
-	)#" + ROUNDED_SHADER_FUNC("pixColor") +
-                                          R"#(
+	)#" + ROUNDED_SHADER_FUNC("pixColor") + R"#(
 
 	gl_FragColor = pixColor * alpha;
 })#";
@@ -233,26 +144,23 @@ varying vec2 v_texcoord;
 uniform sampler2D tex;
 uniform float alpha;
 
-uniform vec2 topLeft;
-uniform vec2 bottomRight;
 uniform vec2 fullSize;
 uniform float radius;
 
-uniform int discardOpaque;
-
-uniform int primitiveMultisample;
-uniform int ignoreCorners;
-
 void main() {
 
-	if (discardOpaque == 1 && alpha == 1.0) {
+#ifdef DISCARDOPAQUE
+	if (alpha == 1.0) {
 		discard;
 		return;
 	}
+#endif
 
 	vec4 pixColor = vec4(texture2D(tex, v_texcoord).rgb, 1.0);
-	
+
+#ifdef ROUNDED
 	vec2 pixCoord = fullSize * v_texcoord;
+#endif
 
 	)#" + ROUNDED_SHADER_FUNC("pixColor") + R"#(
 
@@ -267,9 +175,10 @@ uniform sampler2D tex;
 
 uniform float radius;
 uniform vec2 halfpixel;
+uniform vec2 texscale; // the mirror is smaller than the monitor, see allocBlurBuffers
 
 void main() {
-	vec2 uv = v_texcoord * 2.0;
+	vec2 uv = v_texcoord * 2.0 * texscale;
 
     vec4 sum = texture2D(tex, uv) * 4.0;
     sum += texture2D(tex, uv - halfpixel.xy * radius);
@@ -288,9 +197,10 @@ uniform sampler2D tex;
 
 uniform float radius;
 uniform vec2 halfpixel;
+uniform vec2 texscale;
 
 void main() {
-	vec2 uv = v_texcoord / 2.0;
+	vec2 uv = v_texcoord / 2.0 * texscale;
 
     vec4 sum = texture2D(tex, uv + vec2(-halfpixel.x * 2.0, 0.0) * radius);
     
@@ -311,29 +221,26 @@ inline const std::string TEXFRAGSRCEXT = R"#(
 
 precision mediump float;
 varying vec2 v_texcoord;
-uniform samplerExternalOES texture0;
+uniform samplerExternalOES tex;
 uniform float alpha;
 
-uniform vec2 topLeft;
-uniform vec2 bottomRight;
 uniform vec2 fullSize;
 uniform float radius;
 
-uniform int discardOpaque;
-
-uniform int primitiveMultisample;
-uniform int ignoreCorners;
-
 void main() {
 
-	vec4 pixColor = texture2D(texture0, v_texcoord);
+	vec4 pixColor = texture2D(tex, v_texcoord);
 
-	if (discardOpaque == 1 && pixColor[3] * alpha == 1.0) {
+#ifdef DISCARDOPAQUE
+	if (pixColor[3] * alpha == 1.0) {
 		discard;
 		return;
 	}
+#endif
 
+#ifdef ROUNDED
 	vec2 pixCoord = fullSize * v_texcoord;
+#endif
 
 	)#" + ROUNDED_SHADER_FUNC("pixColor") + R"#(
 
@@ -1,4 +1,5 @@
 #include "Texture.hpp"
+#include "OpenGL.hpp"
 
 CTexture::CTexture() {
     // naffin'
@@ -24,12 +25,19 @@ CTexture::CTexture(wlr_texture* tex) {
 void CTexture::destroyTexture() {
     if (m_iTexID) {
         glDeleteTextures(1, &m_iTexID);
+
+        if (g_pHyprOpenGL) {
+            g_pHyprOpenGL->m_sGLState.onTextureDeleted(m_iTexID);
+            g_pHyprOpenGL->m_sGPUResources.remove(GPU_RESOURCE_TEXTURE, m_iTexID);
+        }
+
         m_iTexID = 0;
     }
 }
 
-void CTexture::allocate() {
+void CTexture::allocate(const SGPUOwner& owner) {
     if (!m_iTexID) {
         glGenTextures(1, &m_iTexID);
+        g_pHyprOpenGL->m_sGPUResources.add(GPU_RESOURCE_TEXTURE, m_iTexID, owner);
     }
 }
\ No newline at end of file
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "../defines.hpp"
+#include "GPUResources.hpp"
 
 enum TEXTURETYPE {
     TEXTURE_INVALID,    // Invalid
@@ -15,7 +16,7 @@ public:
     CTexture(wlr_texture*);
 
     void                destroyTexture();
-    void                allocate();
+    void                allocate(const SGPUOwner& owner = SGPUOwner());
 
     TEXTURETYPE         m_iType = TEXTURE_RGBA;
     GLenum              m_iTarget = GL_TEXTURE_2D;